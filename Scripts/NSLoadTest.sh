@@ -0,0 +1,58 @@
+#!/bin/bash
+# Headless load test on one Linux box.
+# Starts a dedicated server filled with bots and optionally connects
+# -nullrhi clients over loopback so replication is exercised as well.
+#
+# Usage: NSLoadTest.sh [Bots] [Clients] [Seconds]
+#   SERVER_BIN  packaged fpsNSServer binary (default: Binaries/Linux/fpsNSServer)
+#   CLIENT_BIN  packaged fpsNS binary       (default: Binaries/Linux/fpsNS)
+#   MAP         map to load                 (default: FirstPersonExampleMap)
+#   PORT        server port                 (default: 7777)
+#   REPGRAPH    0 falls back to the default net driver relevancy, for A/B runs
+#   CSV_FRAMES  record this many server frames with the CSV profiler
+#               (ServerReplicateActors time is in the CSV as NetServerRepActorsTime)
+
+BOTS=${1:-32}
+CLIENTS=${2:-0}
+SECONDS_TO_RUN=${3:-120}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+SERVER_BIN=${SERVER_BIN:-$ROOT/Binaries/Linux/fpsNSServer}
+CLIENT_BIN=${CLIENT_BIN:-$ROOT/Binaries/Linux/fpsNS}
+MAP=${MAP:-/Game/FirstPersonCPP/Maps/FirstPersonExampleMap}
+PORT=${PORT:-7777}
+LOG_DIR=${LOG_DIR:-$ROOT/Saved/LoadTest}
+
+SERVER_ARGS=()
+if [ "${REPGRAPH:-1}" = "0" ]; then
+	SERVER_ARGS+=("-ini:Engine:[/Script/OnlineSubsystemUtils.IpNetDriver]:ReplicationDriverClassName=None")
+fi
+if [ -n "$CSV_FRAMES" ]; then
+	SERVER_ARGS+=("-csvCaptureFrames=$CSV_FRAMES")
+fi
+
+mkdir -p "$LOG_DIR"
+PIDS=()
+
+cleanup()
+{
+	kill "${PIDS[@]}" 2>/dev/null
+	wait 2>/dev/null
+}
+trap cleanup EXIT INT TERM
+
+# ?Match skips the lobby so bots start fighting after warmup
+"$SERVER_BIN" "$MAP?Match?NSBots=$BOTS" -port=$PORT -unattended -nosound \
+	-abslog="$LOG_DIR/server.log" "${SERVER_ARGS[@]}" &
+PIDS+=($!)
+
+sleep 10
+
+for ((i = 1; i <= CLIENTS; i++)); do
+	"$CLIENT_BIN" 127.0.0.1:$PORT -game -nullrhi -nosound -unattended \
+		-abslog="$LOG_DIR/client_$i.log" &
+	PIDS+=($!)
+done
+
+echo "bots=$BOTS clients=$CLIENTS, running for ${SECONDS_TO_RUN}s, logs in $LOG_DIR"
+sleep "$SECONDS_TO_RUN"
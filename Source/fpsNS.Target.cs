@@ -9,6 +9,16 @@ public class fpsNSTarget : TargetRules
 	{
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V2;
+
+		// Push model needs a unique build environment, which only a source engine can build.
+		// On an installed (launcher) engine the MARK_PROPERTY_DIRTY calls compile away and
+		// push-based properties replicate by comparison as before.
+		if (!UnrealBuildTool.IsEngineInstalled())
+		{
+			BuildEnvironment = TargetBuildEnvironment.Unique;
+			bWithPushModel = true;
+		}
+
 		ExtraModuleNames.Add("fpsNS");
 	}
 }
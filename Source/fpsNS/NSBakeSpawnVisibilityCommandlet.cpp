@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSBakeSpawnVisibilityCommandlet.h"
+#include "NSSpawnPoint.h"
+#include "NSSpawnVisibilityData.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogNSSpawnVisibility, Log, All);
+
+namespace
+{
+	// ĳ ĸ ݳ + ī޶ 
+	const float EyeHeight = 160.0f;
+	const float SpawnEyeHeight = 64.0f;
+}
+
+UNSBakeSpawnVisibilityCommandlet::UNSBakeSpawnVisibilityCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNSBakeSpawnVisibilityCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogNSSpawnVisibility, Error, TEXT("Usage: -run=NSBakeSpawnVisibility -Map=/Game/Path/To/Map [-CellSize=400] [-Samples=4]"));
+		return 1;
+	}
+
+	float CellSize = 400.0f;
+	int32 SamplesPerCell = 4;
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("Samples="), SamplesPerCell);
+	CellSize = FMath::Max(CellSize, 50.0f);
+	SamplesPerCell = FMath::Clamp(SamplesPerCell, 1, 16);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogNSSpawnVisibility, Error, TEXT("Could not load map %s"), *MapName);
+		return 1;
+	}
+
+	// Ʈ̽ ̼ ȸ ʿ ŭ 带 ʱȭѴ
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	World->InitWorld(UWorld::InitializationValues()
+		.AllowAudioPlayback(false)
+		.RequiresHitProxies(false)
+		.CreatePhysicsScene(true)
+		.CreateNavigation(true)
+		.CreateAISystem(false)
+		.ShouldSimulatePhysics(false)
+		.EnableTraceCollision(true)
+		.SetTransactional(false)
+		.CreateFXSystem(false));
+	World->UpdateWorldComponents(true, false);
+
+	if (World->GetNavigationSystem() == nullptr)
+	{
+		FNavigationSystem::AddNavigationSystemToWorld(*World, FNavigationSystemRunMode::EditorMode);
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const FBox NavBounds = NavSys ? NavSys->GetNavigableWorldBounds() : FBox(ForceInit);
+	if (!NavBounds.IsValid)
+	{
+		UE_LOG(LogNSSpawnVisibility, Error, TEXT("%s has no navigation data; build paths before baking"), *MapName);
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	TArray<ANSSpawnPoint*> SpawnPoints;
+	for (TActorIterator<ANSSpawnPoint> It(World); It; ++It)
+	{
+		SpawnPoints.Add(*It);
+	}
+
+	const FString AssetPath = UNSSpawnVisibilityData::GetAssetPathForMap(MapName);
+	UPackage* Package = CreatePackage(*AssetPath);
+	UNSSpawnVisibilityData* Data = NewObject<UNSSpawnVisibilityData>(Package, *FPackageName::GetShortName(AssetPath), RF_Public | RF_Standalone);
+
+	Data->CellSize = CellSize;
+	Data->GridOrigin = NavBounds.Min;
+	Data->GridSize = FIntPoint(
+		FMath::CeilToInt((NavBounds.Max.X - NavBounds.Min.X) / CellSize),
+		FMath::CeilToInt((NavBounds.Max.Y - NavBounds.Min.Y) / CellSize));
+	for (ANSSpawnPoint* SpawnPoint : SpawnPoints)
+	{
+		Data->SpawnPointNames.Add(SpawnPoint->GetFName());
+	}
+
+	const int32 NumCells = Data->GetNumCells();
+	TBitArray<> VisibilityBits(false, NumCells * SpawnPoints.Num());
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(NSBakeSpawnVisibility), true);
+	const FVector ProjectExtent(CellSize * 0.5f, CellSize * 0.5f, NavBounds.GetSize().Z);
+	FRandomStream Random(MapName.Len());
+	int32 NumNavigableCells = 0;
+
+	for (int32 CellY = 0; CellY < Data->GridSize.Y; ++CellY)
+	{
+		for (int32 CellX = 0; CellX < Data->GridSize.X; ++CellX)
+		{
+			const FVector CellMin = Data->GridOrigin + FVector(CellX * CellSize, CellY * CellSize, 0.0f);
+			const FVector CellCenter(CellMin.X + CellSize * 0.5f, CellMin.Y + CellSize * 0.5f, NavBounds.GetCenter().Z);
+
+			//  ߽ɰ   ޽ÿ ؼ    ִ  ġ ´
+			TArray<FVector, TInlineAllocator<16>> EyeLocations;
+			for (int32 Sample = 0; Sample < SamplesPerCell; ++Sample)
+			{
+				const FVector Point = Sample == 0 ? CellCenter
+					: FVector(CellMin.X + Random.FRand() * CellSize, CellMin.Y + Random.FRand() * CellSize, CellCenter.Z);
+
+				FNavLocation NavLocation;
+				if (NavSys->ProjectPointToNavigation(Point, NavLocation, ProjectExtent)
+					&& FMath::FloorToInt((NavLocation.Location.X - Data->GridOrigin.X) / CellSize) == CellX
+					&& FMath::FloorToInt((NavLocation.Location.Y - Data->GridOrigin.Y) / CellSize) == CellY)
+				{
+					EyeLocations.Add(NavLocation.Location + FVector(0.0f, 0.0f, EyeHeight));
+				}
+			}
+
+			if (EyeLocations.Num() == 0)
+			{
+				continue;
+			}
+			++NumNavigableCells;
+
+			const int32 CellIndex = CellY * Data->GridSize.X + CellX;
+			for (int32 SpawnIndex = 0; SpawnIndex < SpawnPoints.Num(); ++SpawnIndex)
+			{
+				const FVector SpawnEye = SpawnPoints[SpawnIndex]->GetActorLocation() + FVector(0.0f, 0.0f, SpawnEyeHeight);
+				for (const FVector& Eye : EyeLocations)
+				{
+					if (!World->LineTraceTestByChannel(Eye, SpawnEye, ECC_Visibility, QueryParams))
+					{
+						VisibilityBits[SpawnIndex * NumCells + CellIndex] = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	Data->SetVisibilityBits(VisibilityBits);
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(AssetPath, FPackageName::GetAssetPackageExtension());
+	const bool bSaved = UPackage::SavePackage(Package, Data, RF_Public | RF_Standalone, *Filename);
+
+	UE_LOG(LogNSSpawnVisibility, Display, TEXT("%s: %d spawn points, %dx%d cells (%d navigable), %d bits -> %s"),
+		*MapName, SpawnPoints.Num(), Data->GridSize.X, Data->GridSize.Y, NumNavigableCells, VisibilityBits.Num(),
+		bSaved ? *Filename : TEXT("save failed"));
+
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	return bSaved ? 0 : 1;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "NSBakeSpawnVisibilityCommandlet.generated.h"
+
+/**
+ *  ̼   ڷ øؼ     ̴ ´.
+ *    <>_SpawnVisibility   Ѵ.
+ *
+ * UE4Editor-Cmd.exe fpsNS.uproject -run=NSBakeSpawnVisibility -Map=/Game/FirstPersonCPP/Maps/FirstPersonExampleMap [-CellSize=400] [-Samples=4]
+ */
+UCLASS()
+class UNSBakeSpawnVisibilityCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UNSBakeSpawnVisibilityCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,359 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "fpsNSCharacter.h"
+#include "fpsNSGameMode.h"
+#include "fpsNSHUD.h"
+#include "NSPlayerState.h"
+#include "NSPawnPool.h"
+#include "NSSpawnPoint.h"
+#include "NSSpawnSelector.h"
+#include "NSLagCompensation.h"
+#include "Camera/CameraComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Tests/AutomationCommon.h"
+#include "TimerManager.h"
+
+#if !UE_BUILD_SHIPPING
+/**  ׸   */
+struct FNSBenchResult
+{
+	FString Name;
+	int32 Calls = 0;
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+
+	void Add(double Seconds)
+	{
+		++Calls;
+		TotalSeconds += Seconds;
+		MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+	}
+
+	double GetMeanMicroseconds() const { return Calls > 0 ? TotalSeconds * 1000000.0 / Calls : 0.0; }
+};
+
+/** ġũ  ĳͿ ڸ */
+struct FNSBenchPlayer
+{
+	AfpsNSCharacter* Character = nullptr;
+	ANSPlayerState* PlayerState = nullptr;
+	FVector Home;
+};
+
+static void WriteBenchResults(const TArray<FNSBenchResult>& Results, int32 NumPlayers, int32 Rounds)
+{
+	const FString BaseName = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("fpsNS_%s"), *FDateTime::Now().ToString());
+
+	FString Csv = TEXT("name,players,rounds,calls,total_ms,mean_us,max_us\n");
+	FString Json = FString::Printf(TEXT("{\n\t\"players\": %d,\n\t\"rounds\": %d,\n\t\"results\": [\n"), NumPlayers, Rounds);
+
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		const FNSBenchResult& Result = Results[Index];
+		Csv += FString::Printf(TEXT("%s,%d,%d,%d,%.3f,%.3f,%.3f\n"), *Result.Name, NumPlayers, Rounds, Result.Calls,
+			Result.TotalSeconds * 1000.0, Result.GetMeanMicroseconds(), Result.MaxSeconds * 1000000.0);
+		Json += FString::Printf(TEXT("\t\t{ \"name\": \"%s\", \"calls\": %d, \"total_ms\": %.3f, \"mean_us\": %.3f, \"max_us\": %.3f }%s\n"),
+			*Result.Name, Result.Calls, Result.TotalSeconds * 1000.0, Result.GetMeanMicroseconds(), Result.MaxSeconds * 1000000.0,
+			Index + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+
+		UE_LOG(LogTemp, Display, TEXT("Bench %-20s %6d calls  mean %9.3f us  max %9.3f us"),
+			*Result.Name, Result.Calls, Result.GetMeanMicroseconds(), Result.MaxSeconds * 1000000.0);
+	}
+	Json += TEXT("\t]\n}\n");
+
+	FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv")));
+	FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json")));
+	UE_LOG(LogTemp, Display, TEXT("Bench results written to %s.csv/.json"), *BaseName);
+}
+
+//  忡 N   ó ڷ . fpsNS  尡 ƴϸ false
+static bool SetupBenchPlayers(UWorld* World, int32 NumPlayers, TArray<FNSBenchPlayer>& OutPlayers)
+{
+	AfpsNSGameMode* GameMode = World ? World->GetAuthGameMode<AfpsNSGameMode>() : nullptr;
+	UNSPawnPool* Pool = World ? World->GetSubsystem<UNSPawnPool>() : nullptr;
+	if (GameMode == nullptr || Pool == nullptr || !GameMode->DefaultPawnClass->IsChildOf(AfpsNSCharacter::StaticClass()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("fpsNS.Bench must run on the server with an fpsNS game mode"));
+		return false;
+	}
+
+	const TSubclassOf<AfpsNSCharacter> CharacterClass(GameMode->DefaultPawnClass.Get());
+
+	//   ó ڷ   ġ ʰ Ѵ
+	FVector Center(0.0f, 0.0f, 200.0f);
+	for (TActorIterator<ANSSpawnPoint> It(World); It; ++It)
+	{
+		Center = It->GetActorLocation();
+		break;
+	}
+
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(float(NumPlayers)));
+	const float Spacing = 300.0f;
+
+	OutPlayers.Reset();
+	for (int32 Index = 0; Index < NumPlayers; ++Index)
+	{
+		FNSBenchPlayer& Player = OutPlayers.AddDefaulted_GetRef();
+		Player.Home = Center + FVector((Index % GridSize - GridSize / 2) * Spacing, (Index / GridSize - GridSize / 2) * Spacing, 0.0f);
+		Player.PlayerState = World->SpawnActor<ANSPlayerState>();
+		Player.PlayerState->SetTeam(ETeam(Index % 2));
+		Player.PlayerState->SetHealth(ANSPlayerState::MaxHealth);
+		Player.Character = Pool->AcquirePawn(CharacterClass);
+		Player.Character->SetNSPlayerState(Player.PlayerState);
+		Player.Character->SetCurrentTeam(Player.PlayerState->GetTeam());
+		Pool->ActivatePawn(Player.Character, Player.Home);
+	}
+	return true;
+}
+
+// غ  ӿ Ѵ.   ƽ ǰ ϰ  ؽð ä
+static TArray<FNSBenchResult> RunBenchRounds(UWorld* World, TArray<FNSBenchPlayer> Players, int32 Rounds)
+{
+	AfpsNSGameMode* GameMode = World->GetAuthGameMode<AfpsNSGameMode>();
+	UNSPawnPool* Pool = World->GetSubsystem<UNSPawnPool>();
+	UNSSpawnSelector* Selector = World->GetSubsystem<UNSSpawnSelector>();
+	UNSLagCompensationSubsystem* LagCompensation = World->GetSubsystem<UNSLagCompensationSubsystem>();
+	const TSubclassOf<AfpsNSCharacter> CharacterClass(GameMode->DefaultPawnClass.Get());
+
+	TArray<ANSSpawnPoint*> SpawnPoints;
+	for (TActorIterator<ANSSpawnPoint> It(World); It; ++It)
+	{
+		SpawnPoints.Add(*It);
+	}
+
+	TArray<FNSBenchResult> Results;
+	Results.SetNum(4);
+	FNSBenchResult& FireTrace = Results[0];
+	FireTrace.Name = TEXT("FireTrace");
+	FNSBenchResult& Damage = Results[1];
+	Damage.Name = TEXT("TakeDamage");
+	FNSBenchResult& Respawn = Results[2];
+	Respawn.Name = TEXT("Respawn");
+	FNSBenchResult& SpawnOverlap = Results[3];
+	SpawnOverlap.Name = TEXT("SpawnPointOverlap");
+
+	const int32 NumPlayers = Players.Num();
+	const float ViewTime = World->GetTimeSeconds() - 0.1f;
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(NSBenchFireTrace));
+	FDamageEvent DamageEvent(UDamageType::StaticClass());
+
+	for (int32 Round = 0; Round < Rounds; ++Round)
+	{
+		//   : ǰ       ˻
+		for (int32 Index = 0; Index < NumPlayers; ++Index)
+		{
+			AfpsNSCharacter* Shooter = Players[Index].Character;
+			AfpsNSCharacter* Target = Players[(Index + NumPlayers / 2) % NumPlayers].Character;
+			const FVector Start = Shooter->GetFirstPersonCameraComponent()->GetComponentLocation();
+			const FVector End = Start + (Target->GetActorLocation() - Start).GetSafeNormal() * Shooter->WeaponRange;
+
+			const double StartTime = FPlatformTime::Seconds();
+			FHitResult Hit;
+			const bool bHit = LagCompensation != nullptr && LagCompensation->RewindTrace(Start, End, ViewTime, Shooter, Hit);
+			TraceParams.ClearIgnoredActors();
+			TraceParams.AddIgnoredActor(Shooter);
+			FHitResult Occlusion;
+			World->LineTraceSingleByChannel(Occlusion, Start, bHit ? Hit.ImpactPoint : End, ECC_Visibility, TraceParams);
+			FireTrace.Add(FPlatformTime::Seconds() - StartTime);
+		}
+
+		for (int32 Index = 0; Index < NumPlayers; ++Index)
+		{
+			AActor* Target = Players[(Index + 1) % NumPlayers].Character;
+
+			const double StartTime = FPlatformTime::Seconds();
+			Target->TakeDamage(1.0f, DamageEvent, nullptr, Players[Index].Character);
+			Damage.Add(FPlatformTime::Seconds() - StartTime);
+
+			Players[(Index + 1) % NumPlayers].PlayerState->SetHealth(ANSPlayerState::MaxHealth);
+		}
+
+		//     : Ǯ ݳ, ,   , ġ
+		for (FNSBenchPlayer& Player : Players)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Pool->ReleasePawn(Player.Character);
+			AfpsNSCharacter* Character = Pool->AcquirePawn(CharacterClass);
+			ANSSpawnPoint* SpawnPoint = Selector ? Selector->SelectSpawnPoint(Player.PlayerState->GetTeam()) : nullptr;
+			Pool->ActivatePawn(Character, SpawnPoint ? SpawnPoint->GetActorLocation() : Player.Home);
+			Respawn.Add(FPlatformTime::Seconds() - StartTime);
+
+			Character->SetNSPlayerState(Player.PlayerState);
+			Character->SetCurrentTeam(Player.PlayerState->GetTeam());
+			Character->SetActorLocation(Player.Home);
+			Player.Character = Character;
+		}
+
+		//      ̺Ʈ Ʈ   
+		for (int32 Index = 0; Index < NumPlayers && SpawnPoints.Num() > 0; ++Index)
+		{
+			AfpsNSCharacter* Character = Players[Index].Character;
+			const FVector SpawnLocation = SpawnPoints[Index % SpawnPoints.Num()]->GetActorLocation();
+
+			const double StartTime = FPlatformTime::Seconds();
+			Character->SetActorLocation(SpawnLocation);
+			Character->SetActorLocation(Players[Index].Home);
+			SpawnOverlap.Add(FPlatformTime::Seconds() - StartTime);
+		}
+	}
+
+	// HUD ĵ ־ ׸  Ƿ ݱ ׸    
+	APlayerController* LocalController = World->GetFirstPlayerController();
+	AfpsNSHUD* HUD = LocalController ? Cast<AfpsNSHUD>(LocalController->GetHUD()) : nullptr;
+	if (HUD != nullptr && HUD->GetAverageDrawSeconds() > 0.0)
+	{
+		FNSBenchResult& HUDDraw = Results.AddDefaulted_GetRef();
+		HUDDraw.Name = TEXT("HUDDraw");
+		HUDDraw.Add(HUD->GetAverageDrawSeconds());
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("Bench HUDDraw skipped: no HUD has drawn in this process (headless)"));
+	}
+
+	for (const FNSBenchPlayer& Player : Players)
+	{
+		Pool->ReleasePawn(Player.Character);
+		Player.PlayerState->Destroy();
+	}
+
+	WriteBenchResults(Results, NumPlayers, Rounds);
+	return Results;
+}
+
+//  忡 N ġϰ  ӿ н 
+static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumPlayers = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 64;
+	const int32 Rounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+	const bool bQuit = Args.Contains(TEXT("quit"));
+
+	TArray<FNSBenchPlayer> Players;
+	if (!SetupBenchPlayers(World, NumPlayers, Players))
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UWorld> WeakWorld(World);
+	World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateLambda([WeakWorld, Players, Rounds, bQuit]()
+	{
+		if (WeakWorld.IsValid())
+		{
+			RunBenchRounds(WeakWorld.Get(), Players, Rounds);
+		}
+
+		if (bQuit)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBench(
+	TEXT("fpsNS.Bench"),
+	TEXT("fpsNS.Bench [Players] [Rounds] [quit]: times fire traces, TakeDamage, respawn and spawn point overlaps on the server and writes Saved/Benchmarks/*.csv and *.json. ")
+	TEXT("Headless: fpsNSServer <Map> -nullrhi -ExecCmds=\"fpsNS.Bench 64 20 quit\""),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmark));
+
+#if WITH_DEV_AUTOMATION_TESTS
+// Ƽ , ĵ, PIE    ִ  
+static UWorld* FindBenchWorld()
+{
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World() != nullptr)
+		{
+			return Context.World();
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * ܼ ɰ  带  ׸  [fpsNS.Benchmark] <Name>BudgetUs Ѵ.
+ *  ų 0̸ ϸ Ѵ.
+ */
+class FNSRunBenchLatentCommand : public IAutomationLatentCommand
+{
+public:
+	FNSRunBenchLatentCommand(FAutomationTestBase* InTest, int32 InNumPlayers, int32 InRounds)
+		: Test(InTest), NumPlayers(InNumPlayers), Rounds(InRounds)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		UWorld* World = FindBenchWorld();
+		if (!bPrepared)
+		{
+			if (!SetupBenchPlayers(World, NumPlayers, Players))
+			{
+				Test->AddError(TEXT("No game world with an fpsNS game mode to benchmark"));
+				return true;
+			}
+
+			//   ƽؼ ǰ ϰ  ؽø ä
+			bPrepared = true;
+			return false;
+		}
+
+		if (World == nullptr)
+		{
+			Test->AddError(TEXT("Game world went away before the benchmark ran"));
+			return true;
+		}
+
+		for (const FNSBenchResult& Result : RunBenchRounds(World, Players, Rounds))
+		{
+			float BudgetUs = 0.0f;
+			GConfig->GetFloat(TEXT("fpsNS.Benchmark"), *(Result.Name + TEXT("BudgetUs")), BudgetUs, GGameIni);
+			if (BudgetUs > 0.0f && Result.GetMeanMicroseconds() > BudgetUs)
+			{
+				Test->AddError(FString::Printf(TEXT("%s: mean %.3f us exceeds budget %.3f us"), *Result.Name, Result.GetMeanMicroseconds(), BudgetUs));
+			}
+		}
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	int32 NumPlayers;
+	int32 Rounds;
+	TArray<FNSBenchPlayer> Players;
+	bool bPrepared = false;
+};
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FNSServerHotPathBenchmarkTest, "fpsNS.Benchmark.ServerHotPath",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FNSServerHotPathBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	const FString& MapName = GetDefault<AfpsNSGameMode>()->MatchMap;
+	OutBeautifiedNames.Add(FPackageName::GetShortName(MapName));
+	OutTestCommands.Add(MapName);
+}
+
+// 帮: fpsNSServer -nullrhi -ExecCmds="Automation RunTests fpsNS.Benchmark; Quit"
+bool FNSServerHotPathBenchmarkTest::RunTest(const FString& Parameters)
+{
+	int32 NumPlayers = 64;
+	int32 Rounds = 20;
+	GConfig->GetInt(TEXT("fpsNS.Benchmark"), TEXT("Players"), NumPlayers, GGameIni);
+	GConfig->GetInt(TEXT("fpsNS.Benchmark"), TEXT("Rounds"), Rounds, GGameIni);
+
+	AutomationOpenMap(Parameters);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(1.0f));
+	ADD_LATENT_AUTOMATION_COMMAND(FNSRunBenchLatentCommand(this, FMath::Max(2, NumPlayers), FMath::Max(1, Rounds)));
+	return true;
+}
+#endif
+#endif
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSBotController.h"
+#include "fpsNSCharacter.h"
+#include "NSSpawnSelector.h"
+#include "NavigationSystem.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Camera/CameraComponent.h"
+#include "TimerManager.h"
+
+ANSBotController::ANSBotController()
+{
+	//   ÷̾   Ѵ
+	bWantsPlayerState = true;
+}
+
+void ANSBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	//    ӿ Ǵ ʵ   ߸
+	GetWorldTimerManager().SetTimer(ThinkTimer, this, &ANSBotController::Think, ThinkInterval, true, FMath::FRand() * ThinkInterval);
+}
+
+void ANSBotController::OnUnPossess()
+{
+	GetWorldTimerManager().ClearTimer(ThinkTimer);
+	StopMovement();
+	ClearFocus(EAIFocusPriority::Gameplay);
+
+	Super::OnUnPossess();
+}
+
+void ANSBotController::Think()
+{
+	AfpsNSCharacter* Character = Cast<AfpsNSCharacter>(GetPawn());
+	if (Character == nullptr || Character->bIsDead || Character->IsHidden())
+	{
+		return;
+	}
+
+	UNSSpawnSelector* Selector = GetWorld()->GetSubsystem<UNSSpawnSelector>();
+	AfpsNSCharacter* Enemy = Selector ? Selector->FindNearestEnemy(Character->GetActorLocation(), Character->CurrentTeam, SightRadius) : nullptr;
+
+	if (Enemy == nullptr || !LineOfSightTo(Enemy))
+	{
+		ClearFocus(EAIFocusPriority::Gameplay);
+		Wander();
+		return;
+	}
+
+	SetFocus(Enemy);
+	StopMovement();
+
+	const FVector Origin = Character->GetFirstPersonCameraComponent()->GetComponentLocation();
+	const FVector Direction = (Enemy->GetActorLocation() - Origin).GetSafeNormal();
+	Character->SendFireCommand(Origin, FMath::VRandCone(Direction, FMath::DegreesToRadians(AimError)));
+}
+
+void ANSBotController::Wander()
+{
+	if (GetMoveStatus() != EPathFollowingStatus::Idle)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	FNavLocation Destination;
+	if (NavSys != nullptr && NavSys->GetRandomReachablePointInRadius(GetPawn()->GetActorLocation(), WanderRadius, Destination))
+	{
+		MoveToLocation(Destination.Location);
+	}
+}
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "NSBotController.generated.h"
+
+/**
+ *  ׽Ʈ . ޽  ƴٴϴ     ؼ .
+ * ߻ ÷̾  ServerFire θ Ƿ , ,   ״ ȴ.
+ */
+UCLASS(config=Game)
+class FPSNS_API ANSBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	ANSBotController();
+
+	/** Ǵ ֱ ().     ֱ ߻Ѵ */
+	UPROPERTY(Config)
+	float ThinkInterval = 0.1f;
+
+	/**  ã ݰ (cm) */
+	UPROPERTY(Config)
+	float SightRadius = 5000.0f;
+
+	/**    ̵   ݰ (cm) */
+	UPROPERTY(Config)
+	float WanderRadius = 2000.0f;
+
+	/**   () */
+	UPROPERTY(Config)
+	float AimError = 2.0f;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	void Think();
+
+	//   ó   ִ  ̵Ѵ
+	void Wander();
+
+	FTimerHandle ThinkTimer;
+};
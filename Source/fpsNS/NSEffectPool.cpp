@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSEffectPool.h"
+#include "fpsNS.h"
+#include "Engine/World.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Pool Hits"), STAT_fpsNS_EffectPoolHits, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Pool Misses"), STAT_fpsNS_EffectPoolMisses, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Effect Pool Steals"), STAT_fpsNS_EffectPoolSteals, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Emitters Active"), STAT_fpsNS_EmittersActive, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Emitters Free"), STAT_fpsNS_EmittersFree, STATGROUP_fpsNS);
+
+void UNSEffectPool::Deinitialize()
+{
+	for (TPair<UParticleSystem*, FNSEmitterPool>& Pair : Pools)
+	{
+		for (UParticleSystemComponent* Emitter : Pair.Value.Free)
+		{
+			Emitter->DestroyComponent();
+		}
+		for (UParticleSystemComponent* Emitter : Pair.Value.Active)
+		{
+			Emitter->DestroyComponent();
+		}
+	}
+	Pools.Reset();
+
+	Super::Deinitialize();
+}
+
+void UNSEffectPool::Prewarm(UParticleSystem* Template)
+{
+	if (Template == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	FNSEmitterPool& Pool = Pools.FindOrAdd(Template);
+	while (Pool.Free.Num() + Pool.Active.Num() < FMath::Min(PrewarmCount, MaxPerTemplate))
+	{
+		Pool.Free.Add(CreateEmitter(Template));
+	}
+
+	UpdateStats();
+}
+
+UParticleSystemComponent* UNSEffectPool::SpawnEmitterAtLocation(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation)
+{
+	if (Template == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return nullptr;
+	}
+
+	FNSEmitterPool& Pool = Pools.FindOrAdd(Template);
+	UParticleSystemComponent* Emitter = nullptr;
+
+	if (Pool.Free.Num() > 0)
+	{
+		Emitter = Pool.Free.Pop(false);
+		INC_DWORD_STAT(STAT_fpsNS_EffectPoolHits);
+	}
+	else if (Pool.Active.Num() < MaxPerTemplate)
+	{
+		Emitter = CreateEmitter(Template);
+		INC_DWORD_STAT(STAT_fpsNS_EffectPoolMisses);
+	}
+	else
+	{
+		// ѿ    ̹͸ ٽ 
+		Emitter = Pool.Active[0];
+		Pool.Active.RemoveAt(0, 1, false);
+		Emitter->DeactivateImmediate();
+		INC_DWORD_STAT(STAT_fpsNS_EffectPoolSteals);
+	}
+
+	Emitter->SetWorldLocationAndRotation(Location, Rotation);
+	Emitter->ActivateSystem(true);
+	Pool.Active.Add(Emitter);
+
+	UpdateStats();
+	return Emitter;
+}
+
+UParticleSystemComponent* UNSEffectPool::CreateEmitter(UParticleSystem* Template)
+{
+	UParticleSystemComponent* Emitter = NewObject<UParticleSystemComponent>(GetWorld());
+	Emitter->bAutoDestroy = false;
+	Emitter->bAutoActivate = false;
+	Emitter->SetTemplate(Template);
+	Emitter->OnSystemFinished.AddDynamic(this, &UNSEffectPool::OnEmitterFinished);
+	Emitter->RegisterComponentWithWorld(GetWorld());
+	return Emitter;
+}
+
+void UNSEffectPool::OnEmitterFinished(UParticleSystemComponent* Emitter)
+{
+	FNSEmitterPool* Pool = Pools.Find(Emitter->Template);
+	if (Pool != nullptr && Pool->Active.Remove(Emitter) > 0)
+	{
+		Pool->Free.Add(Emitter);
+		UpdateStats();
+	}
+}
+
+void UNSEffectPool::UpdateStats() const
+{
+	int32 NumActive = 0;
+	int32 NumFree = 0;
+	for (const TPair<UParticleSystem*, FNSEmitterPool>& Pair : Pools)
+	{
+		NumActive += Pair.Value.Active.Num();
+		NumFree += Pair.Value.Free.Num();
+	}
+
+	SET_DWORD_STAT(STAT_fpsNS_EmittersActive, NumActive);
+	SET_DWORD_STAT(STAT_fpsNS_EmittersFree, NumFree);
+}
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSEffectPool.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/** ø ϳ  ̹ Ǯ */
+USTRUCT()
+struct FNSEmitterPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> Free;
+
+	//   ̹.    
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> Active;
+};
+
+/**
+ * ߻/ǰ ƼŬ Ʈ ø ̸  ΰ Ѵ.
+ *   Ǯ ƿ, ѿ    ̹͸  .
+ */
+UCLASS(config=Game)
+class FPSNS_API UNSEffectPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// ø PrewarmCount ̸ 
+	void Prewarm(UParticleSystem* Template);
+
+	UParticleSystemComponent* SpawnEmitterAtLocation(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation);
+
+	/** ø ̸   ̹  */
+	UPROPERTY(Config)
+	int32 PrewarmCount = 8;
+
+	/** ø ִ ̹  */
+	UPROPERTY(Config)
+	int32 MaxPerTemplate = 32;
+
+private:
+	UParticleSystemComponent* CreateEmitter(UParticleSystem* Template);
+
+	UFUNCTION()
+	void OnEmitterFinished(UParticleSystemComponent* Emitter);
+
+	void UpdateStats() const;
+
+	UPROPERTY()
+	TMap<UParticleSystem*, FNSEmitterPool> Pools;
+};
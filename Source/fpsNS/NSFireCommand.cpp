@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSFireCommand.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNet.h"
+#include "HAL/IConsoleManager.h"
+
+void FNSFireCommand::SetDirection(const FVector& Direction)
+{
+	const FRotator Rotation = Direction.Rotation();
+	PackedDirection = (uint32(FRotator::CompressAxisToShort(Rotation.Yaw)) << 16) | uint32(FRotator::CompressAxisToShort(Rotation.Pitch));
+}
+
+FVector FNSFireCommand::GetDirection() const
+{
+	const float Yaw = FRotator::DecompressAxisFromShort(uint16(PackedDirection >> 16));
+	const float Pitch = FRotator::DecompressAxisFromShort(uint16(PackedDirection & 0xFFFF));
+	return FRotator(Pitch, Yaw, 0.0f).Vector();
+}
+
+void FNSFireCommand::SetTimestamp(float ServerTime)
+{
+	TimestampMs = uint16(FMath::FloorToInt(ServerTime * 1000.0f) & 0xFFFF);
+}
+
+float FNSFireCommand::GetViewTime(float ServerNow) const
+{
+	const int32 NowMs = FMath::FloorToInt(ServerNow * 1000.0f);
+
+	// 16Ʈ ̸ ȣ ִ  ؼѴ ( 32 )
+	const int16 DeltaMs = int16(uint16(NowMs & 0xFFFF) - TimestampMs);
+	return ServerNow - DeltaMs / 1000.0f;
+}
+
+bool FNSFireCommand::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = SerializePackedVector<1, 20>(Origin, Ar);
+	Ar << PackedDirection;
+	Ar << Sequence;
+	Ar << TimestampMs;
+	return true;
+}
+
+bool FNSFireRateLimiter::TryConsume(float Now, float Rate, float Burst)
+{
+	if (LastRefillTime < 0.0f)
+	{
+		Tokens = Burst;
+	}
+	else
+	{
+		Tokens = FMath::Min(Burst, Tokens + (Now - LastRefillTime) * Rate);
+	}
+	LastRefillTime = Now;
+
+	if (Tokens >= 1.0f)
+	{
+		Tokens -= 1.0f;
+		return true;
+	}
+	return false;
+}
+
+void FNSFireRateLimiter::Reset()
+{
+	Tokens = 0.0f;
+	LastRefillTime = -1.0f;
+}
+
+#if !UE_BUILD_SHIPPING
+//  ServerFire ڿ FNSFireCommand ȭ ũ⸦ Ѵ
+static void LogFireCommandBits()
+{
+	const FVector Origin(2350.4f, -1820.7f, 172.0f);
+	const FVector Direction = FVector(0.8f, 0.55f, -0.12f).GetSafeNormal();
+
+	FNetBitWriter OldWriter(nullptr, 1024);
+	FVector OldPos = Origin;
+	FVector OldDir = Direction * 10000000.0f;
+	float OldViewTime = 123.456f;
+	OldWriter << OldPos << OldDir << OldViewTime;
+
+	FNSFireCommand Command;
+	Command.Origin = Origin;
+	Command.SetDirection(Direction);
+	Command.Sequence = 42;
+	Command.SetTimestamp(123.456f);
+
+	FNetBitWriter NewWriter(nullptr, 1024);
+	bool bSuccess = false;
+	Command.NetSerialize(NewWriter, nullptr, bSuccess);
+
+	const int64 OldBits = OldWriter.GetNumBits();
+	const int64 NewBits = NewWriter.GetNumBits();
+	UE_LOG(LogTemp, Display, TEXT("ServerFire payload: old %lld bits, FNSFireCommand %lld bits (%.0f%%)"),
+		OldBits, NewBits, 100.0 * NewBits / OldBits);
+	UE_LOG(LogTemp, Display, TEXT("64 players x 10 shots/s: old %.1f kbit/s, new %.1f kbit/s"),
+		OldBits * 640 / 1000.0, NewBits * 640 / 1000.0);
+}
+
+static FAutoConsoleCommand CmdFireCommandBits(
+	TEXT("fpsNS.FireCommandBits"),
+	TEXT("Logs the serialized size of the ServerFire payload before and after quantization."),
+	FConsoleCommandDelegate::CreateStatic(&LogFireCommandBits));
+#endif
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NSFireCommand.generated.h"
+
+/**
+ * Ŭ̾Ʈ   ߻ .
+ *  1cm  ȭϰ  yaw/pitch 16Ʈ 32Ʈ ´.
+ * ߻   , ,  Ÿ ٽ Ѵ.
+ */
+USTRUCT()
+struct FPSNS_API FNSFireCommand
+{
+	GENERATED_BODY()
+
+	/** ߻  (ī޶ ġ) */
+	FVector Origin = FVector::ZeroVector;
+
+	/**  16Ʈ yaw,  16Ʈ pitch */
+	uint32 PackedDirection = 0;
+
+	/** ߻ . 255  0 ư */
+	uint8 Sequence = 0;
+
+	/** Ŭ̾Ʈ ȭ   ð  16Ʈ (ms) */
+	uint16 TimestampMs = 0;
+
+	void SetDirection(const FVector& Direction);
+	FVector GetDirection() const;
+
+	void SetTimestamp(float ServerTime);
+
+	//   ð  16Ʈ Ÿӽ Ǯ Ŭ̾Ʈ  Ѵ
+	float GetViewTime(float ServerNow) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+/**   ӵ Ǵ ū Ŷ.  ߻  Ÿ   */
+struct FPSNS_API FNSFireRateLimiter
+{
+	// ū   ϳ Ҹϰ true ȯѴ
+	bool TryConsume(float Now, float Rate, float Burst);
+
+	void Reset();
+
+private:
+	float Tokens = 0.0f;
+	float LastRefillTime = -1.0f;
+};
+
+template<>
+struct TStructOpsTypeTraits<FNSFireCommand> : public TStructOpsTypeTraitsBase2<FNSFireCommand>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
@@ -2,16 +2,62 @@
 
 
 #include "NSGameStateBase.h"
+#include "NSTeamInfo.h"
+#include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
 
 ANSGameStateBase::ANSGameStateBase()
 {
-	bInMenu = false;
+	MatchPhase = ENSMatchPhase::Lobby;
+	PhaseEndTime = 0.0f;
+	NumTeams = 2;
+}
+
+void ANSGameStateBase::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	if (HasAuthority() && GetWorld()->IsGameWorld())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = this;
+		for (int32 Index = 0; Index < int32(ETeam::MAX); ++Index)
+		{
+			ANSTeamInfo* TeamInfo = GetWorld()->SpawnActor<ANSTeamInfo>(SpawnParams);
+			TeamInfo->Team = ETeam(Index);
+			TeamInfos.Add(TeamInfo);
+		}
+	}
 }
 
 void ANSGameStateBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ANSGameStateBase, bInMenu);
-}
\ No newline at end of file
+	DOREPLIFETIME(ANSGameStateBase, MatchPhase);
+	DOREPLIFETIME(ANSGameStateBase, PhaseEndTime);
+	DOREPLIFETIME(ANSGameStateBase, NumTeams);
+}
+
+void ANSGameStateBase::SetMatchPhase(ENSMatchPhase NewPhase, float Duration)
+{
+	PhaseEndTime = Duration > 0.0f ? GetServerWorldTimeSeconds() + Duration : 0.0f;
+
+	if (MatchPhase != NewPhase)
+	{
+		MatchPhase = NewPhase;
+
+		//  RepNotify  Ƿ  ȣѴ
+		OnRep_MatchPhase();
+	}
+}
+
+float ANSGameStateBase::GetPhaseTimeRemaining() const
+{
+	return PhaseEndTime > 0.0f ? FMath::Max(PhaseEndTime - GetServerWorldTimeSeconds(), 0.0f) : 0.0f;
+}
+
+void ANSGameStateBase::OnRep_MatchPhase()
+{
+	OnMatchPhaseChanged.Broadcast(MatchPhase);
+}
@@ -4,8 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameStateBase.h"
+#include "NSTeamRegistry.h"
 #include "NSGameStateBase.generated.h"
 
+class ANSTeamInfo;
+
+UENUM(BlueprintType)
+enum class ENSMatchPhase : uint8
+{
+	Lobby,
+	Warmup,
+	InProgress,
+	PostMatch
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FNSOnMatchPhaseChanged, ENSMatchPhase);
+
 /**
  * 
  */
@@ -17,6 +31,35 @@ class FPSNS_API ANSGameStateBase : public AGameStateBase
 public:
 	ANSGameStateBase();
 
-UPROPERTY(Replicated)
-	bool bInMenu;
+	virtual void PostInitializeComponents() override;
+
+	//  ܰ踦 ٲ۴. Duration 0̸  ð 
+	void SetMatchPhase(ENSMatchPhase NewPhase, float Duration);
+
+	bool IsInLobby() const { return MatchPhase == ENSMatchPhase::Lobby; }
+
+	//  ܰ  ð ().  ð  0
+	float GetPhaseTimeRemaining() const;
+
+	// :  ü     .  ϳ
+	ANSTeamInfo* GetTeamInfo(ETeam Team) const { return TeamInfos.IsValidIndex(int32(Team)) ? TeamInfos[int32(Team)] : nullptr; }
+
+	UPROPERTY(ReplicatedUsing = OnRep_MatchPhase, BlueprintReadOnly)
+	ENSMatchPhase MatchPhase;
+
+	//   ð  ܰ  ð
+	UPROPERTY(Replicated)
+	float PhaseEndTime;
+
+	UPROPERTY(Replicated)
+	uint8 NumTeams;
+
+	FNSOnMatchPhaseChanged OnMatchPhaseChanged;
+
+protected:
+	UFUNCTION()
+	void OnRep_MatchPhase();
+
+	UPROPERTY(Transient)
+	TArray<ANSTeamInfo*> TeamInfos;
 };
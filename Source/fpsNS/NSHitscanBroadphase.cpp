@@ -0,0 +1,281 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSHitscanBroadphase.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	//       0 ĸ ä
+	const float PaddingCoord = 1.0e9f;
+}
+
+void FNSCapsuleBroadphase::Reset()
+{
+	AX.Reset(); AY.Reset(); AZ.Reset();
+	EX.Reset(); EY.Reset(); EZ.Reset();
+	Radii.Reset();
+	NumCapsules = 0;
+}
+
+int32 FNSCapsuleBroadphase::Add(const FVector& A, const FVector& B, float Radius)
+{
+	if (NumCapsules % 4 == 0)
+	{
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			AX.Add(PaddingCoord); AY.Add(PaddingCoord); AZ.Add(PaddingCoord);
+			EX.Add(0.0f); EY.Add(0.0f); EZ.Add(1.0f);
+			Radii.Add(0.0f);
+		}
+	}
+
+	const int32 Index = NumCapsules++;
+	const FVector E = B - A;
+	AX[Index] = A.X; AY[Index] = A.Y; AZ[Index] = A.Z;
+	EX[Index] = E.X; EY[Index] = E.Y; EZ[Index] = E.Z;
+	Radii[Index] = Radius;
+	return Index;
+}
+
+void FNSCapsuleBroadphase::GatherCandidates(const FVector& Start, const FVector& End, FCandidateArray& OutCandidates) const
+{
+	const FVector Delta = End - Start;
+	const float Length = Delta.Size();
+	if (Length <= KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+	const FVector Dir = Delta / Length;
+
+	const VectorRegister SX = VectorSetFloat1(Start.X);
+	const VectorRegister SY = VectorSetFloat1(Start.Y);
+	const VectorRegister SZ = VectorSetFloat1(Start.Z);
+	const VectorRegister DX = VectorSetFloat1(Dir.X);
+	const VectorRegister DY = VectorSetFloat1(Dir.Y);
+	const VectorRegister DZ = VectorSetFloat1(Dir.Z);
+	const VectorRegister MaxS = VectorSetFloat1(Length);
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister One = VectorOne();
+	const VectorRegister ParallelEpsilon = VectorSetFloat1(1.0e-4f);
+
+	//  а ĸ  ִ Ÿ 4 Ѵ
+	for (int32 Base = 0; Base < NumCapsules; Base += 4)
+	{
+		const VectorRegister CAX = VectorLoadAligned(&AX[Base]);
+		const VectorRegister CAY = VectorLoadAligned(&AY[Base]);
+		const VectorRegister CAZ = VectorLoadAligned(&AZ[Base]);
+		const VectorRegister CEX = VectorLoadAligned(&EX[Base]);
+		const VectorRegister CEY = VectorLoadAligned(&EY[Base]);
+		const VectorRegister CEZ = VectorLoadAligned(&EZ[Base]);
+		const VectorRegister CR = VectorLoadAligned(&Radii[Base]);
+
+		const VectorRegister RX = VectorSubtract(SX, CAX);
+		const VectorRegister RY = VectorSubtract(SY, CAY);
+		const VectorRegister RZ = VectorSubtract(SZ, CAZ);
+
+		const VectorRegister E = VectorMultiplyAdd(CEX, CEX, VectorMultiplyAdd(CEY, CEY, VectorMultiply(CEZ, CEZ)));
+		const VectorRegister F = VectorMultiplyAdd(CEX, RX, VectorMultiplyAdd(CEY, RY, VectorMultiply(CEZ, RZ)));
+		const VectorRegister C = VectorMultiplyAdd(DX, RX, VectorMultiplyAdd(DY, RY, VectorMultiply(DZ, RZ)));
+		const VectorRegister B = VectorMultiplyAdd(DX, CEX, VectorMultiplyAdd(DY, CEY, VectorMultiply(DZ, CEZ)));
+
+		//     ֱ s, ϸ 0 Ѵ
+		const VectorRegister Denom = VectorSubtract(E, VectorMultiply(B, B));
+		const VectorRegister SNum = VectorSubtract(VectorMultiply(B, F), VectorMultiply(C, E));
+		const VectorRegister NotParallel = VectorCompareGT(Denom, VectorMultiply(ParallelEpsilon, E));
+		VectorRegister S = VectorSelect(NotParallel, VectorDivide(SNum, Denom), Zero);
+		S = VectorMin(VectorMax(S, Zero), MaxS);
+
+		// t ĸ п    t   s ٽ Ѵ
+		VectorRegister T = VectorDivide(VectorMultiplyAdd(B, S, F), E);
+		T = VectorMin(VectorMax(T, Zero), One);
+		S = VectorSubtract(VectorMultiply(B, T), C);
+		S = VectorMin(VectorMax(S, Zero), MaxS);
+
+		const VectorRegister DiffX = VectorSubtract(VectorMultiplyAdd(DX, S, RX), VectorMultiply(CEX, T));
+		const VectorRegister DiffY = VectorSubtract(VectorMultiplyAdd(DY, S, RY), VectorMultiply(CEY, T));
+		const VectorRegister DiffZ = VectorSubtract(VectorMultiplyAdd(DZ, S, RZ), VectorMultiply(CEZ, T));
+		const VectorRegister DistSq = VectorMultiplyAdd(DiffX, DiffX, VectorMultiplyAdd(DiffY, DiffY, VectorMultiply(DiffZ, DiffZ)));
+
+		const int32 HitMask = VectorMaskBits(VectorCompareLE(DistSq, VectorMultiply(CR, CR)));
+		if (HitMask != 0)
+		{
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				if ((HitMask & (1 << Lane)) && Base + Lane < NumCapsules)
+				{
+					OutCandidates.Add(Base + Lane);
+				}
+			}
+		}
+	}
+}
+
+bool FNSCapsuleBroadphase::Raycast(const FVector& Start, const FVector& End, int32& OutIndex, float& OutDistance) const
+{
+	FCandidateArray Candidates;
+	GatherCandidates(Start, End, Candidates);
+
+	const FVector Delta = End - Start;
+	const float Length = Delta.Size();
+	const FVector Dir = Delta / Length;
+
+	OutIndex = INDEX_NONE;
+	OutDistance = Length;
+	for (int32 Index : Candidates)
+	{
+		const FVector A(AX[Index], AY[Index], AZ[Index]);
+		const FVector B = A + FVector(EX[Index], EY[Index], EZ[Index]);
+		const float Distance = IntersectRayCapsule(Start, Dir, A, B, Radii[Index]);
+		if (Distance >= 0.0f && Distance <= OutDistance)
+		{
+			OutDistance = Distance;
+			OutIndex = Index;
+		}
+	}
+	return OutIndex != INDEX_NONE;
+}
+
+float FNSCapsuleBroadphase::IntersectRayCapsule(const FVector& Origin, const FVector& Dir, const FVector& Pa, const FVector& Pb, float Radius)
+{
+	const float RadiusSq = Radius * Radius;
+	float BestT = BIG_NUMBER;
+
+	//  
+	const FVector Ba = Pb - Pa;
+	const FVector Oa = Origin - Pa;
+	const float BaBa = Ba | Ba;
+	const float BaRd = Ba | Dir;
+	const float BaOa = Ba | Oa;
+	const float RdOa = Dir | Oa;
+	const float OaOa = Oa | Oa;
+	const float A = BaBa - BaRd * BaRd;
+
+	if (A > KINDA_SMALL_NUMBER)
+	{
+		const float B = BaBa * RdOa - BaOa * BaRd;
+		const float C = BaBa * OaOa - BaOa * BaOa - RadiusSq * BaBa;
+		const float H = B * B - A * C;
+		if (H >= 0.0f)
+		{
+			const float T = (-B - FMath::Sqrt(H)) / A;
+			const float Y = BaOa + T * BaRd;
+			if (T >= 0.0f && Y > 0.0f && Y < BaBa)
+			{
+				BestT = T;
+			}
+		}
+	}
+
+	//   ݱ
+	for (const FVector& Cap : { Pa, Pb })
+	{
+		const FVector Oc = Origin - Cap;
+		const float B = Dir | Oc;
+		const float C = (Oc | Oc) - RadiusSq;
+		const float H = B * B - C;
+		if (H >= 0.0f)
+		{
+			const float T = -B - FMath::Sqrt(H);
+			if (T >= 0.0f && T < BestT)
+			{
+				BestT = T;
+			}
+		}
+	}
+
+	return BestT < BIG_NUMBER ? BestT : -1.0f;
+}
+
+#if !UE_BUILD_SHIPPING
+// ĳ     Ʈ̽ SIMD ε ߻  Ѵ
+static void RunHitscanBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	const int32 NumShots = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+	const float CapsuleRadius = 55.0f;
+	const float CapsuleHalfHeight = 96.0f;
+	const FBox Arena(FVector(-5000.0f, -5000.0f, 0.0f), FVector(5000.0f, 5000.0f, 500.0f));
+
+	for (int32 NumCharacters : { 16, 64, 128 })
+	{
+		FRandomStream Random(NumCharacters);
+		FNSCapsuleBroadphase Broadphase;
+		TArray<AActor*> Dummies;
+		TArray<FVector> Centers;
+
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			const FVector Center(Random.FRandRange(Arena.Min.X, Arena.Max.X), Random.FRandRange(Arena.Min.Y, Arena.Max.Y), Random.FRandRange(Arena.Min.Z, Arena.Max.Z));
+			Centers.Add(Center);
+
+			AActor* Dummy = World->SpawnActor<AActor>(Center, FRotator::ZeroRotator);
+			UCapsuleComponent* Capsule = NewObject<UCapsuleComponent>(Dummy);
+			Capsule->InitCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+			Capsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			Capsule->SetCollisionObjectType(ECC_GameTraceChannel1);
+			Dummy->SetRootComponent(Capsule);
+			Capsule->RegisterComponent();
+			Dummy->SetActorLocation(Center);
+			Dummies.Add(Dummy);
+
+			const FVector Axis(0.0f, 0.0f, CapsuleHalfHeight - CapsuleRadius);
+			Broadphase.Add(Center - Axis, Center + Axis, CapsuleRadius);
+		}
+
+		//  ĳ͸ ܳϰ    
+		TArray<TPair<FVector, FVector>> Rays;
+		for (int32 Shot = 0; Shot < NumShots; ++Shot)
+		{
+			const FVector Start(Random.FRandRange(Arena.Min.X, Arena.Max.X), Random.FRandRange(Arena.Min.Y, Arena.Max.Y), Random.FRandRange(Arena.Min.Z, Arena.Max.Z));
+			const FVector Dir = (Shot % 2 == 0)
+				? (Centers[Random.RandHelper(NumCharacters)] + Random.VRand() * 50.0f - Start).GetSafeNormal()
+				: Random.VRand();
+			Rays.Emplace(Start, Start + Dir * 100000.0f);
+		}
+
+		FCollisionObjectQueryParams ObjQuery;
+		ObjQuery.AddObjectTypesToQuery(ECC_GameTraceChannel1);
+		int32 SceneHits = 0;
+		const double SceneStart = FPlatformTime::Seconds();
+		for (const TPair<FVector, FVector>& Ray : Rays)
+		{
+			FHitResult Hit;
+			SceneHits += World->LineTraceSingleByObjectType(Hit, Ray.Key, Ray.Value, ObjQuery) ? 1 : 0;
+		}
+		const double SceneSeconds = FPlatformTime::Seconds() - SceneStart;
+
+		int32 BroadphaseHits = 0;
+		const double BroadphaseStart = FPlatformTime::Seconds();
+		for (const TPair<FVector, FVector>& Ray : Rays)
+		{
+			int32 HitIndex;
+			float HitDistance;
+			BroadphaseHits += Broadphase.Raycast(Ray.Key, Ray.Value, HitIndex, HitDistance) ? 1 : 0;
+		}
+		const double BroadphaseSeconds = FPlatformTime::Seconds() - BroadphaseStart;
+
+		UE_LOG(LogTemp, Display, TEXT("Hitscan %3d characters, %d shots: scene trace %.3f us/shot (%d hits), SIMD broadphase %.3f us/shot (%d hits)"),
+			NumCharacters, NumShots,
+			SceneSeconds * 1.0e6 / NumShots, SceneHits,
+			BroadphaseSeconds * 1.0e6 / NumShots, BroadphaseHits);
+
+		for (AActor* Dummy : Dummies)
+		{
+			Dummy->Destroy();
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdHitscanBench(
+	TEXT("fpsNS.HitscanBench"),
+	TEXT("fpsNS.HitscanBench [Shots]: compares the physics scene trace with the SIMD capsule broadphase at 16/64/128 characters."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunHitscanBenchmark));
+#endif
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * ĳ ĸ SoA 迭 Ƶΰ  4 SIMD ˻ϴ Ʈĵ ε.
+ * ĸ  A-B  ǥѴ.
+ */
+struct FPSNS_API FNSCapsuleBroadphase
+{
+	typedef TArray<int32, TInlineAllocator<16>> FCandidateArray;
+
+	void Reset();
+
+	// ĸ ߰ϰ ε ȯѴ
+	int32 Add(const FVector& A, const FVector& B, float Radius);
+
+	int32 Num() const { return NumCapsules; }
+
+	// Start-End а ִ Ÿ   ĸ 
+	void GatherCandidates(const FVector& Start, const FVector& End, FCandidateArray& OutCandidates) const;
+
+	//   ĸ  ã´
+	bool Raycast(const FVector& Start, const FVector& End, int32& OutIndex, float& OutDistance) const;
+
+	// ȭ  ĸ ù  Ÿ.   -1
+	static float IntersectRayCapsule(const FVector& Origin, const FVector& Dir, const FVector& A, const FVector& B, float Radius);
+
+private:
+	typedef TArray<float, TAlignedHeapAllocator<16>> FFloatArray;
+
+	// SIMD    4  ä
+	FFloatArray AX, AY, AZ;
+	FFloatArray EX, EY, EZ;
+	FFloatArray Radii;
+	int32 NumCapsules = 0;
+};
@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSHitscanResolver.h"
+#include "fpsNS.h"
+#include "fpsNSCharacter.h"
+#include "NSLagCompensation.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Queued"), STAT_fpsNS_ShotsQueued, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Resolved"), STAT_fpsNS_ShotsResolved, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shots Hit"), STAT_fpsNS_ShotsHit, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shots In Flight"), STAT_fpsNS_ShotsInFlight, STATGROUP_fpsNS);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Shots/sec"), STAT_fpsNS_ShotsPerSec, STATGROUP_fpsNS);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Hits/sec"), STAT_fpsNS_HitsPerSec, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("Hitscan Resolve"), STAT_fpsNS_HitscanResolve, STATGROUP_fpsNS);
+
+void UNSHitscanResolver::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency(UNSLagCompensationSubsystem::StaticClass());
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UNSHitscanResolver::OnWorldPostActorTick);
+}
+
+void UNSHitscanResolver::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingShots.Reset();
+	InFlightShots.Reset();
+	Super::Deinitialize();
+}
+
+void UNSHitscanResolver::QueueShot(AfpsNSCharacter* Shooter, const FVector& Start, const FVector& End, float ViewTime)
+{
+	FNSQueuedShot& Shot = PendingShots.AddDefaulted_GetRef();
+	Shot.Shooter = Shooter;
+	Shot.Start = Start;
+	Shot.End = End;
+	Shot.ViewTime = ViewTime;
+
+	INC_DWORD_STAT(STAT_fpsNS_ShotsQueued);
+	ShotRate.Add();
+}
+
+void UNSHitscanResolver::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_fpsNS_HitscanResolve);
+		CSV_SCOPED_TIMING_STAT(fpsNS, HitscanResolve);
+		ResolveInFlightShots();
+		SubmitPendingShots();
+	}
+
+	ShotRate.Tick(DeltaSeconds);
+	HitRate.Tick(DeltaSeconds);
+
+	SET_DWORD_STAT(STAT_fpsNS_ShotsInFlight, InFlightShots.Num());
+	SET_FLOAT_STAT(STAT_fpsNS_ShotsPerSec, ShotRate.GetRate());
+	SET_FLOAT_STAT(STAT_fpsNS_HitsPerSec, HitRate.GetRate());
+	CSV_CUSTOM_STAT(fpsNS, ShotsPerSec, ShotRate.GetRate(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(fpsNS, HitsPerSec, HitRate.GetRate(), ECsvCustomStatOp::Set);
+}
+
+void UNSHitscanResolver::ResolveInFlightShots()
+{
+	if (InFlightShots.Num() == 0)
+	{
+		return;
+	}
+
+	//   ؼ  ƽ  ׻  Ѵ
+	for (const FNSQueuedShot& Shot : InFlightShots)
+	{
+		AfpsNSCharacter* Shooter = Shot.Shooter.Get();
+		if (Shooter == nullptr)
+		{
+			continue;
+		}
+
+		FVector BlockPoint;
+		if (IsOccluded(Shot, BlockPoint))
+		{
+			Shooter->RecordShotEvent(Shot.Start, BlockPoint);
+		}
+		else
+		{
+			Shooter->OnShotResolved(Shot.Hit);
+			Shooter->RecordShotEvent(Shot.Start, Shot.Hit.ImpactPoint);
+			INC_DWORD_STAT(STAT_fpsNS_ShotsHit);
+			HitRate.Add();
+		}
+
+		INC_DWORD_STAT(STAT_fpsNS_ShotsResolved);
+	}
+
+	InFlightShots.Reset();
+}
+
+void UNSHitscanResolver::SubmitPendingShots()
+{
+	UNSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UNSLagCompensationSubsystem>();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(NSHitscanOcclusion));
+
+	for (FNSQueuedShot& Shot : PendingShots)
+	{
+		// ĳ͸   ߻    ٷ 
+		if (LagCompensation == nullptr || !LagCompensation->RewindTrace(Shot.Start, Shot.End, Shot.ViewTime, Shot.Shooter.Get(), Shot.Hit))
+		{
+			if (AfpsNSCharacter* Shooter = Shot.Shooter.Get())
+			{
+				Shooter->RecordShotEvent(Shot.Start, Shot.End);
+			}
+			INC_DWORD_STAT(STAT_fpsNS_ShotsResolved);
+			continue;
+		}
+
+		//       ˻Ѵ
+		Params.ClearIgnoredActors();
+		Params.AddIgnoredActor(Shot.Shooter.Get());
+		Shot.OcclusionTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.Start, Shot.Hit.ImpactPoint, ECC_Visibility, Params);
+
+		InFlightShots.Add(Shot);
+	}
+
+	PendingShots.Reset();
+}
+
+bool UNSHitscanResolver::IsOccluded(const FNSQueuedShot& Shot, FVector& OutBlockPoint) const
+{
+	FTraceDatum Datum;
+	if (GetWorld()->QueryTraceData(Shot.OcclusionTrace, Datum))
+	{
+		for (const FHitResult& Hit : Datum.OutHits)
+		{
+			if (Hit.bBlockingHit)
+			{
+				OutBlockPoint = Hit.ImpactPoint;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//   ߴٸ ( ǳʶ )  Ʈ̽ Ѵ
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(NSHitscanOcclusion), false, Shot.Shooter.Get());
+	FHitResult Hit;
+	if (GetWorld()->LineTraceSingleByChannel(Hit, Shot.Start, Shot.Hit.ImpactPoint, ECC_Visibility, Params))
+	{
+		OutBlockPoint = Hit.ImpactPoint;
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fpsNS.h"
+#include "WorldCollision.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSHitscanResolver.generated.h"
+
+class AfpsNSCharacter;
+
+/**    Ʈĵ ߻ */
+struct FNSQueuedShot
+{
+	TWeakObjectPtr<AfpsNSCharacter> Shooter;
+	FVector Start;
+	FVector End;
+	float ViewTime;
+
+	// ǰ ĸ   
+	FHitResult Hit;
+	FTraceHandle OcclusionTrace;
+};
+
+/**
+ *  ƽ   ߻縦  ǰ ĸ  ,     ˻縦
+ * 񵿱 Ʈ̽ ϰ  ƽ      Ѵ.
+ */
+UCLASS()
+class FPSNS_API UNSHitscanResolver : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void QueueShot(AfpsNSCharacter* Shooter, const FVector& Start, const FVector& End, float ViewTime);
+
+private:
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	//  ƽ   Ʈ̽   ȮѴ
+	void ResolveInFlightShots();
+
+	// ̹ ƽ  ߻縦 ĸ ε ϰ  ͸  Ʈ̽ Ѵ
+	void SubmitPendingShots();
+
+	bool IsOccluded(const FNSQueuedShot& Shot, FVector& OutBlockPoint) const;
+
+	TArray<FNSQueuedShot> PendingShots;
+	TArray<FNSQueuedShot> InFlightShots;
+
+	FDelegateHandle PostActorTickHandle;
+
+	// stat fpsNS CSV Ϸ  ʴ ߻,  
+	FNSRateCounter ShotRate;
+	FNSRateCounter HitRate;
+};
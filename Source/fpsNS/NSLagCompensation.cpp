@@ -0,0 +1,245 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSLagCompensation.h"
+#include "NSHitscanBroadphase.h"
+#include "fpsNSCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+//////////////////////////////////////////////////////////////////////////
+// FNSHitboxHistory
+
+void FNSHitboxHistory::Record(const FNSHitboxFrame& Frame)
+{
+	Head = (Head + 1) % NumFrames;
+	Frames[Head] = Frame;
+	Count = FMath::Min(Count + 1, NumFrames);
+}
+
+float FNSHitboxHistory::GetMaxDeviation(const FNSHitboxFrame& Current, float SinceTime) const
+{
+	float MaxDeviation = 0.0f;
+	for (int32 Age = 0; Age < Count; ++Age)
+	{
+		const FNSHitboxFrame& Frame = GetFrame(Age);
+		const float Deviation = FVector::Dist(Frame.Location, Current.Location)
+			+ FMath::Abs(Frame.HalfHeight - Current.HalfHeight) + FMath::Max(Frame.Radius - Current.Radius, 0.0f);
+		MaxDeviation = FMath::Max(MaxDeviation, Deviation);
+
+		//    ӱ ؾ    ´
+		if (Frame.Time < SinceTime)
+		{
+			break;
+		}
+	}
+	return MaxDeviation;
+}
+
+void FNSHitboxHistory::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+
+bool FNSHitboxHistory::Sample(float Time, FNSHitboxFrame& OutFrame) const
+{
+	if (Count == 0)
+	{
+		return false;
+	}
+
+	//   ̸    Ѵ
+	if (Time >= GetFrame(0).Time)
+	{
+		OutFrame = GetFrame(0);
+		return true;
+	}
+
+	if (Time <= GetFrame(Count - 1).Time)
+	{
+		OutFrame = GetFrame(Count - 1);
+		return true;
+	}
+
+	for (int32 Age = 1; Age < Count; ++Age)
+	{
+		const FNSHitboxFrame& Older = GetFrame(Age);
+		if (Older.Time <= Time)
+		{
+			const FNSHitboxFrame& Newer = GetFrame(Age - 1);
+			const float Span = Newer.Time - Older.Time;
+			const float Alpha = Span > SMALL_NUMBER ? (Time - Older.Time) / Span : 1.0f;
+
+			OutFrame.Time = Time;
+			OutFrame.Location = FMath::Lerp(Older.Location, Newer.Location, Alpha);
+			OutFrame.Rotation = FQuat::Slerp(Older.Rotation, Newer.Rotation, Alpha);
+			OutFrame.Radius = FMath::Lerp(Older.Radius, Newer.Radius, Alpha);
+			OutFrame.HalfHeight = FMath::Lerp(Older.HalfHeight, Newer.HalfHeight, Alpha);
+			return true;
+		}
+	}
+
+	OutFrame = GetFrame(Count - 1);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UNSLagCompensationSubsystem
+
+void UNSLagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UNSLagCompensationSubsystem::OnWorldPostActorTick);
+}
+
+void UNSLagCompensationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	Characters.Reset();
+	Super::Deinitialize();
+}
+
+void UNSLagCompensationSubsystem::RegisterCharacter(AfpsNSCharacter* Character)
+{
+	if (Character != nullptr && !Characters.Contains(Character))
+	{
+		Characters.Add(Character);
+		Character->GetHitboxHistory().Reset();
+
+		// ù ƽ  ߻Ǿ ǰ  ֵ Ѵ
+		RecordFrame(Character, GetWorld()->GetTimeSeconds());
+		RebuildBroadphase();
+	}
+}
+
+void UNSLagCompensationSubsystem::UnregisterCharacter(AfpsNSCharacter* Character)
+{
+	if (Characters.RemoveSwap(Character) > 0)
+	{
+		RebuildBroadphase();
+	}
+}
+
+float UNSLagCompensationSubsystem::ClampRewindTime(float ViewTime) const
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	return FMath::Clamp(ViewTime, Now - MaxRewindTime, Now);
+}
+
+bool UNSLagCompensationSubsystem::RewindTrace(const FVector& Start, const FVector& End, float ViewTime, const AActor* IgnoreActor, FHitResult& OutHit) const
+{
+	const FVector Delta = End - Start;
+	const float MaxDistance = Delta.Size();
+	if (MaxDistance <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector Dir = Delta / MaxDistance;
+	const float RewindTime = ClampRewindTime(ViewTime);
+
+	// ǰ  ü  ĸ ĺ  ߸
+	FNSCapsuleBroadphase::FCandidateArray Candidates;
+	Broadphase.GatherCandidates(Start, End, Candidates);
+
+	AfpsNSCharacter* BestCharacter = nullptr;
+	FNSHitboxFrame BestFrame;
+	float BestDistance = MaxDistance;
+
+	for (int32 Index : Candidates)
+	{
+		AfpsNSCharacter* Character = Characters[Index];
+		if (Character == nullptr || Character == IgnoreActor)
+		{
+			continue;
+		}
+
+		FNSHitboxFrame Frame;
+		if (!Character->GetHitboxHistory().Sample(RewindTime, Frame))
+		{
+			continue;
+		}
+
+		const FVector Axis = Frame.Rotation.GetUpVector() * FMath::Max(Frame.HalfHeight - Frame.Radius, 0.0f);
+		const float Distance = FNSCapsuleBroadphase::IntersectRayCapsule(Start, Dir, Frame.Location - Axis, Frame.Location + Axis, Frame.Radius);
+		if (Distance >= 0.0f && Distance <= BestDistance)
+		{
+			BestDistance = Distance;
+			BestCharacter = Character;
+			BestFrame = Frame;
+		}
+	}
+
+	if (BestCharacter == nullptr)
+	{
+		return false;
+	}
+
+	const FVector HitLocation = Start + Dir * BestDistance;
+	const FVector Axis = BestFrame.Rotation.GetUpVector() * FMath::Max(BestFrame.HalfHeight - BestFrame.Radius, 0.0f);
+	const FVector Closest = FMath::ClosestPointOnSegment(HitLocation, BestFrame.Location - Axis, BestFrame.Location + Axis);
+
+	OutHit = FHitResult(BestCharacter, BestCharacter->GetCapsuleComponent(), HitLocation, (HitLocation - Closest).GetSafeNormal());
+	OutHit.bBlockingHit = true;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Distance = BestDistance;
+	OutHit.Time = BestDistance / MaxDistance;
+	return true;
+}
+
+void UNSLagCompensationSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	// ̵   ĸ ¸ Ѵ
+	const float Now = World->GetTimeSeconds();
+	for (AfpsNSCharacter* Character : Characters)
+	{
+		if (Character != nullptr)
+		{
+			RecordFrame(Character, Now);
+		}
+	}
+
+	RebuildBroadphase();
+}
+
+void UNSLagCompensationSubsystem::RebuildBroadphase()
+{
+	Broadphase.Reset();
+
+	const float SinceTime = GetWorld()->GetTimeSeconds() - MaxRewindTime;
+	for (AfpsNSCharacter* Character : Characters)
+	{
+		FNSHitboxFrame Current;
+		if (Character == nullptr || !Character->GetHitboxHistory().Sample(BIG_NUMBER, Current))
+		{
+			// ε Characters ߱   ĸ ִ´
+			Broadphase.Add(FVector(WORLD_MAX), FVector(WORLD_MAX) + FVector::UpVector, 0.0f);
+			continue;
+		}
+
+		const float Inflate = Character->GetHitboxHistory().GetMaxDeviation(Current, SinceTime);
+		const FVector Axis = Current.Rotation.GetUpVector() * FMath::Max(Current.HalfHeight - Current.Radius, 0.0f);
+		Broadphase.Add(Current.Location - Axis, Current.Location + Axis, Current.Radius + Inflate);
+	}
+}
+
+void UNSLagCompensationSubsystem::RecordFrame(AfpsNSCharacter* Character, float Time) const
+{
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+
+	FNSHitboxFrame Frame;
+	Frame.Time = Time;
+	Frame.Location = Capsule->GetComponentLocation();
+	Frame.Rotation = Capsule->GetComponentQuat();
+	Frame.Radius = Capsule->GetScaledCapsuleRadius();
+	Frame.HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+
+	Character->GetHitboxHistory().Record(Frame);
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NSHitscanBroadphase.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSLagCompensation.generated.h"
+
+class AfpsNSCharacter;
+
+/**   ĸ Ʈڽ  */
+struct FNSHitboxFrame
+{
+	float Time = 0.0f;
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	float Radius = 0.0f;
+	float HalfHeight = 0.0f;
+};
+
+/** ֱ Ʈڽ ¸ ϴ  ũ   */
+struct FPSNS_API FNSHitboxHistory
+{
+	static constexpr int32 NumFrames = 32;
+
+	void Record(const FNSHitboxFrame& Frame);
+	void Reset();
+
+	// SinceTime   Current  ִ Ÿ
+	float GetMaxDeviation(const FNSHitboxFrame& Current, float SinceTime) const;
+
+	// Time  Ʈڽ յ   Ѵ
+	bool Sample(float Time, FNSHitboxFrame& OutFrame) const;
+
+private:
+	const FNSHitboxFrame& GetFrame(int32 Age) const
+	{
+		return Frames[(Head - Age + NumFrames) % NumFrames];
+	}
+
+	FNSHitboxFrame Frames[NumFrames];
+	int32 Head = 0;
+	int32 Count = 0;
+};
+
+/**
+ *  ĳ Ʈڽ  ϰ Ŭ̾Ʈ  ǰ Ʈĵ Ѵ.
+ *   ʹ  ʰ ϵ ĸ    ˻縦 Ѵ.
+ */
+UCLASS(config=Game)
+class FPSNS_API UNSLagCompensationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void RegisterCharacter(AfpsNSCharacter* Character);
+	void UnregisterCharacter(AfpsNSCharacter* Character);
+
+	// Ŭ̾Ʈ  ð   ǰ  Ѵ
+	float ClampRewindTime(float ViewTime) const;
+
+	// ViewTime  ǰ ĸ鿡  Start-End  ˻Ѵ
+	bool RewindTrace(const FVector& Start, const FVector& End, float ViewTime, const AActor* IgnoreActor, FHitResult& OutHit) const;
+
+	/** ִ ǰ ð () */
+	UPROPERTY(Config)
+	float MaxRewindTime = 0.25f;
+
+private:
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void RecordFrame(AfpsNSCharacter* Character, float Time) const;
+
+	// ǰ  Ӹŭ Ǯ  ĸ ε ٽ 
+	void RebuildBroadphase();
+
+	UPROPERTY()
+	TArray<AfpsNSCharacter*> Characters;
+
+	// Characters   ĸ SoA
+	FNSCapsuleBroadphase Broadphase;
+
+	FDelegateHandle PostActorTickHandle;
+};
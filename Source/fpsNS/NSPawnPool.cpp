@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSPawnPool.h"
+#include "fpsNS.h"
+#include "fpsNSCharacter.h"
+#include "NSLagCompensation.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawn Pool Hits"), STAT_fpsNS_PawnPoolHits, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawn Pool Misses"), STAT_fpsNS_PawnPoolMisses, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pawns Pooled"), STAT_fpsNS_PawnsPooled, STATGROUP_fpsNS);
+
+void UNSPawnPool::Deinitialize()
+{
+	FreePawns.Reset();
+	Super::Deinitialize();
+}
+
+void UNSPawnPool::ReleasePawn(AfpsNSCharacter* Character)
+{
+	if (Character == nullptr || FreePawns.Contains(Character))
+	{
+		return;
+	}
+
+	if (AController* Controller = Character->GetController())
+	{
+		Controller->UnPossess();
+	}
+
+	if (UNSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UNSLagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(Character);
+	}
+
+	SetPawnActive(Character, false);
+
+	//  ¸    ٽ   ޸Ѵ
+	Character->SetNetActivity(ENSNetActivity::Dormant);
+	Character->FlushNetDormancy();
+
+	FreePawns.Add(Character);
+
+	UpdateStats();
+}
+
+AfpsNSCharacter* UNSPawnPool::AcquirePawn(TSubclassOf<AfpsNSCharacter> CharacterClass)
+{
+	AfpsNSCharacter* Character = nullptr;
+
+	//  ֱٿ   
+	for (int32 Index = FreePawns.Num() - 1; Index >= 0; --Index)
+	{
+		if (FreePawns[Index] == nullptr || FreePawns[Index]->IsPendingKill())
+		{
+			FreePawns.RemoveAtSwap(Index);
+		}
+		else if (FreePawns[Index]->GetClass() == CharacterClass)
+		{
+			Character = FreePawns[Index];
+			FreePawns.RemoveAtSwap(Index);
+			break;
+		}
+	}
+
+	if (Character != nullptr)
+	{
+		INC_DWORD_STAT(STAT_fpsNS_PawnPoolHits);
+	}
+	else
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Character = GetWorld()->SpawnActor<AfpsNSCharacter>(CharacterClass, FTransform::Identity, Params);
+		if (Character == nullptr)
+		{
+			return nullptr;
+		}
+		SetPawnActive(Character, false);
+		INC_DWORD_STAT(STAT_fpsNS_PawnPoolMisses);
+	}
+
+	Character->ResetForRespawn();
+	UpdateStats();
+	return Character;
+}
+
+void UNSPawnPool::ActivatePawn(AfpsNSCharacter* Character, const FVector& Location)
+{
+	// 浹  Ѿ ̵    ħ ̺Ʈ ߻Ѵ
+	SetPawnActive(Character, true);
+	Character->SetActorLocation(Location, false, nullptr, ETeleportType::ResetPhysics);
+	Character->SetNetActivity(ENSNetActivity::Idle);
+
+	// ̵  ġ ǰ Ͽ  ʵ   Ѵ
+	if (UNSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UNSLagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(Character);
+		LagCompensation->RegisterCharacter(Character);
+	}
+}
+
+void UNSPawnPool::SetPawnActive(AfpsNSCharacter* Character, bool bActive)
+{
+	Character->SetActorHiddenInGame(!bActive);
+	Character->SetActorEnableCollision(bActive);
+	Character->SetActorTickEnabled(bActive);
+
+	UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+	Movement->StopMovementImmediately();
+	if (bActive)
+	{
+		Movement->SetMovementMode(MOVE_Walking);
+	}
+	else
+	{
+		Movement->DisableMovement();
+	}
+}
+
+void UNSPawnPool::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_fpsNS_PawnsPooled, FreePawns.Num());
+}
+
+#if !UE_BUILD_SHIPPING
+//      ı   Ǯ  Ѵ
+static void RunRespawnBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	UNSPawnPool* Pool = World ? World->GetSubsystem<UNSPawnPool>() : nullptr;
+	if (GameMode == nullptr || Pool == nullptr || !GameMode->DefaultPawnClass->IsChildOf(AfpsNSCharacter::StaticClass()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("fpsNS.RespawnBench must run on the server with an fpsNS game mode"));
+		return;
+	}
+
+	const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64;
+	const TSubclassOf<AfpsNSCharacter> CharacterClass(GameMode->DefaultPawnClass.Get());
+	const FVector Location(0.0f, 0.0f, 10000.0f);
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		AfpsNSCharacter* Character = World->SpawnActor<AfpsNSCharacter>(CharacterClass, FTransform(Location), Params);
+		Character->Destroy();
+	}
+	const double SpawnTime = FPlatformTime::Seconds() - StartTime;
+
+	AfpsNSCharacter* Pooled = Pool->AcquirePawn(CharacterClass);
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Pool->ReleasePawn(Pooled);
+		Pooled = Pool->AcquirePawn(CharacterClass);
+		Pool->ActivatePawn(Pooled, Location);
+	}
+	const double PoolTime = FPlatformTime::Seconds() - StartTime;
+	Pool->ReleasePawn(Pooled);
+
+	UE_LOG(LogTemp, Display, TEXT("Respawn x%d: SpawnActor+Destroy %.3f ms/respawn, pool %.3f ms/respawn"),
+		Count, SpawnTime * 1000.0 / Count, PoolTime * 1000.0 / Count);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRespawnBench(
+	TEXT("fpsNS.RespawnBench"),
+	TEXT("fpsNS.RespawnBench [Count]: compares server cost per respawn for SpawnActor+Destroy and the pawn pool."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunRespawnBenchmark));
+#endif
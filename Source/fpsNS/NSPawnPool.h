@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSPawnPool.generated.h"
+
+class AfpsNSCharacter;
+
+/**
+ *  ĳ͸ ı ʰ  ξٰ  ٽ .
+ *  , Ŭ̾Ʈ ä , GC   ġ ʴ´.
+ */
+UCLASS()
+class FPSNS_API UNSPawnPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Ǹ ϰ   Ǯ ִ´
+	void ReleasePawn(AfpsNSCharacter* Character);
+
+	// Ǯ  ʱȭѴ.   .      · д
+	AfpsNSCharacter* AcquirePawn(TSubclassOf<AfpsNSCharacter> CharacterClass);
+
+	//  Ǯ ġ ű
+	void ActivatePawn(AfpsNSCharacter* Character, const FVector& Location);
+
+	int32 GetNumPooled() const { return FreePawns.Num(); }
+
+private:
+	static void SetPawnActive(AfpsNSCharacter* Character, bool bActive);
+
+	void UpdateStats() const;
+
+	UPROPERTY()
+	TArray<AfpsNSCharacter*> FreePawns;
+};
@@ -2,19 +2,144 @@
 
 
 #include "NSPlayerState.h"
+#include "NSGameStateBase.h"
+#include "NSTeamInfo.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 ANSPlayerState::ANSPlayerState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
-	Health = 100.0f;
+	Health = MaxHealth;
+	OwnerHealth = MAX_uint8;
 	Deaths = 0;
 	Team = ETeam::BLUE_TEAM;
 }
 
+void ANSPlayerState::CopyProperties(APlayerState* PlayerState)
+{
+	Super::CopyProperties(PlayerState);
+
+	if (ANSPlayerState* NSPlayerState = Cast<ANSPlayerState>(PlayerState))
+	{
+		NSPlayerState->SetTeam(Team);
+		NSPlayerState->Deaths = Deaths;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ANSPlayerState, Deaths, NSPlayerState);
+		NSPlayerState->bTeamAssigned = bTeamAssigned;
+	}
+}
+
+void ANSPlayerState::OverrideWith(APlayerState* PlayerState)
+{
+	Super::OverrideWith(PlayerState);
+
+	if (ANSPlayerState* NSPlayerState = Cast<ANSPlayerState>(PlayerState))
+	{
+		SetTeam(NSPlayerState->Team);
+		Deaths = NSPlayerState->Deaths;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ANSPlayerState, Deaths, this);
+		bTeamAssigned = NSPlayerState->bTeamAssigned;
+	}
+}
+
+void ANSPlayerState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdateTeamHealth();
+}
+
+void ANSPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ANSTeamInfo* TeamInfo = HasAuthority() ? GetTeamInfo() : nullptr)
+	{
+		TeamInfo->RemoveMember(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ANSPlayerState::SetHealth(float NewHealth)
+{
+	Health = FMath::Clamp(NewHealth, 0.0f, MaxHealth);
+
+	// ȭ  ٲ  Ƽ ǥѴ
+	const uint8 NewOwnerHealth = uint8(FMath::RoundToInt(Health / MaxHealth * MAX_uint8));
+	if (NewOwnerHealth != OwnerHealth)
+	{
+		OwnerHealth = NewOwnerHealth;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ANSPlayerState, OwnerHealth, this);
+	}
+
+	UpdateTeamHealth();
+}
+
+void ANSPlayerState::ApplyTeamHealth(uint8 CoarseHealth)
+{
+	if (Cast<APlayerController>(GetOwner()) == nullptr)
+	{
+		Health = CoarseHealth * MaxHealth / 10.0f;
+	}
+}
+
+void ANSPlayerState::UpdateTeamHealth()
+{
+	if (!HasAuthority() || !HasActorBegunPlay())
+	{
+		return;
+	}
+
+	if (ANSTeamInfo* TeamInfo = GetTeamInfo())
+	{
+		TeamInfo->SetMemberHealth(this, uint8(FMath::CeilToInt(Health / MaxHealth * 10.0f)));
+	}
+}
+
+ANSTeamInfo* ANSPlayerState::GetTeamInfo() const
+{
+	const ANSGameStateBase* GameState = GetWorld() ? GetWorld()->GetGameState<ANSGameStateBase>() : nullptr;
+	return GameState ? GameState->GetTeamInfo(Team) : nullptr;
+}
+
+void ANSPlayerState::AddDeath()
+{
+	++Deaths;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ANSPlayerState, Deaths, this);
+}
+
+void ANSPlayerState::SetTeam(ETeam NewTeam)
+{
+	if (Team != NewTeam)
+	{
+		//   Űܼ    ̻ ü  ʴ´
+		if (ANSTeamInfo* OldTeamInfo = HasAuthority() ? GetTeamInfo() : nullptr)
+		{
+			OldTeamInfo->RemoveMember(this);
+		}
+
+		Team = NewTeam;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ANSPlayerState, Team, this);
+		UpdateTeamHealth();
+	}
+}
+
+void ANSPlayerState::OnRep_OwnerHealth()
+{
+	Health = OwnerHealth * MaxHealth / MAX_uint8;
+}
+
 void ANSPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(ANSPlayerState, Health);
-	DOREPLIFETIME(ANSPlayerState, Deaths);
-	DOREPLIFETIME(ANSPlayerState, Team);
-}
\ No newline at end of file
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	Params.Condition = COND_ReplayOrOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ANSPlayerState, OwnerHealth, Params);
+
+	Params.Condition = COND_None;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ANSPlayerState, Deaths, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ANSPlayerState, Team, Params);
+}
@@ -7,17 +7,60 @@
 #include "GameFramework/PlayerState.h"
 #include "NSPlayerState.generated.h"
 
+class ANSTeamInfo;
+
 /**
- * 
+ *   Ǫ 𵨷 Ѵ.  ͷθ ٲ Ƽ ǥð ȴ.
+ * ü ڿԴ 8Ʈ, Դ ANSTeamInfo 10ܰθ  ٸ   ʴ´.
  */
 UCLASS()
 class FPSNS_API ANSPlayerState : public APlayerState
 {
 	GENERATED_UCLASS_BODY()
 
-	UPROPERTY(Replicated)
+public:
+	// ɸ ̵      ÷̾ Ʈ ѱ
+	virtual void CopyProperties(APlayerState* PlayerState) override;
+	virtual void OverrideWith(APlayerState* PlayerState) override;
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	static constexpr float MaxHealth = 100.0f;
+
+	//  Ȯ , Ŭ̾Ʈ  ȭ 
+	float GetHealth() const { return Health; }
+	void SetHealth(float NewHealth);
+
+	// Ŭ̾Ʈ:    10ܰ ü ݿѴ. ڴ 8Ʈ  
+	void ApplyTeamHealth(uint8 CoarseHealth);
+
+	uint8 GetDeaths() const { return Deaths; }
+	void AddDeath();
+
+	ETeam GetTeam() const { return Team; }
+	void SetTeam(ETeam NewTeam);
+
+	//    Ʈ  ()
+	FNSTeamHandle TeamHandle;
+
+	//    ޾Ҵ. ɸ ̵    ٽ 
+	bool bTeamAssigned = false;
+
+private:
+	UFUNCTION()
+	void OnRep_OwnerHealth();
+
+	// :     10ܰ ü ø
+	void UpdateTeamHealth();
+	ANSTeamInfo* GetTeamInfo() const;
+
 	float Health;
 
+	// 0-255 ȭ ü. ڿ ÷̿ 
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerHealth)
+	uint8 OwnerHealth;
+
 	UPROPERTY(Replicated)
 	uint8 Deaths;
 
@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSRagdollManager.h"
+#include "fpsNS.h"
+#include "fpsNSCharacter.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ragdolls Simulating"), STAT_fpsNS_RagdollsSimulating, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ragdolls Fallback"), STAT_fpsNS_RagdollsFallback, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ragdolls Frozen"), STAT_fpsNS_RagdollsFrozen, STATGROUP_fpsNS);
+
+void UNSRagdollManager::Deinitialize()
+{
+	if (UpdateTimer.IsValid())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(UpdateTimer);
+	}
+	Entries.Reset();
+
+	Super::Deinitialize();
+}
+
+void UNSRagdollManager::RequestRagdoll(AfpsNSCharacter* Character)
+{
+	// Ƽ    Ƿ ùķ̼ ʴ´
+	if (Character == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	ReleaseRagdoll(Character);
+
+	//  ׸ ֱ    ׸ ̳   ׵  ʴ´
+	const bool bHasBudget = CountInState(ENSRagdollState::Simulating) < MaxSimulatingRagdolls;
+
+	//  á   ׵   ڸ Ѱܹ޴´
+	FVector ViewLocation;
+	float FarthestDistSq = 0.0f;
+	const int32 Farthest = !bHasBudget && GetViewLocation(ViewLocation) ? FindFarthestSimulating(ViewLocation, FarthestDistSq) : INDEX_NONE;
+
+	FNSRagdollEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = Character;
+	Entry.StartTime = GetWorld()->GetTimeSeconds();
+
+	if (bHasBudget)
+	{
+		StartSimulation(Entry);
+	}
+	else if (Farthest != INDEX_NONE && FVector::DistSquared(Character->GetActorLocation(), ViewLocation) < FarthestDistSq)
+	{
+		Freeze(Entries[Farthest]);
+		StartSimulation(Entry);
+	}
+	else
+	{
+		StartFallback(Entry);
+	}
+
+	if (!UpdateTimer.IsValid())
+	{
+		GetWorld()->GetTimerManager().SetTimer(UpdateTimer, this, &UNSRagdollManager::UpdateRagdolls, UpdateInterval, true);
+	}
+
+	UpdateStats();
+}
+
+void UNSRagdollManager::ReleaseRagdoll(AfpsNSCharacter* Character)
+{
+	Entries.RemoveAllSwap([Character](const FNSRagdollEntry& Entry)
+	{
+		return Entry.Character.Get() == Character;
+	});
+
+	UpdateStats();
+}
+
+void UNSRagdollManager::UpdateRagdolls()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+	{
+		FNSRagdollEntry& Entry = Entries[Index];
+		AfpsNSCharacter* Character = Entry.Character.Get();
+		if (Character == nullptr)
+		{
+			Entries.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (Entry.State == ENSRagdollState::Frozen)
+		{
+			continue;
+		}
+
+		if (Now - Entry.StartTime > FreezeTimeout)
+		{
+			Freeze(Entry);
+			continue;
+		}
+
+		if (Entry.State == ENSRagdollState::Simulating)
+		{
+			const float Speed = Character->GetMesh()->GetPhysicsLinearVelocity().Size();
+			if (Speed > SettleSpeed)
+			{
+				Entry.SettledTime = -1.0f;
+			}
+			else if (Entry.SettledTime < 0.0f)
+			{
+				Entry.SettledTime = Now;
+			}
+			else if (Now - Entry.SettledTime > SettleDuration)
+			{
+				Freeze(Entry);
+			}
+		}
+	}
+
+	if (CountInState(ENSRagdollState::Frozen) == Entries.Num())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(UpdateTimer);
+	}
+
+	UpdateStats();
+}
+
+void UNSRagdollManager::StartSimulation(FNSRagdollEntry& Entry)
+{
+	USkeletalMeshComponent* Mesh = Entry.Character->GetMesh();
+	Mesh->SetPhysicsBlendWeight(1.0f);
+	Mesh->SetSimulatePhysics(true);
+	Mesh->SetCollisionProfileName("Ragdoll");
+
+	Entry.State = ENSRagdollState::Simulating;
+	Entry.SettledTime = -1.0f;
+}
+
+void UNSRagdollManager::StartFallback(FNSRagdollEntry& Entry)
+{
+	AfpsNSCharacter* Character = Entry.Character.Get();
+	if (Character->DeathAnimation != nullptr)
+	{
+		Character->GetMesh()->PlayAnimation(Character->DeathAnimation, false);
+		Entry.State = ENSRagdollState::Fallback;
+	}
+	else
+	{
+		Freeze(Entry);
+	}
+}
+
+void UNSRagdollManager::Freeze(FNSRagdollEntry& Entry)
+{
+	// ƽ ߸  Ʈ   ´
+	USkeletalMeshComponent* Mesh = Entry.Character->GetMesh();
+	Mesh->SetComponentTickEnabled(false);
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	Entry.State = ENSRagdollState::Frozen;
+}
+
+int32 UNSRagdollManager::FindFarthestSimulating(const FVector& ViewLocation, float& OutDistSq) const
+{
+	int32 Farthest = INDEX_NONE;
+	OutDistSq = -1.0f;
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FNSRagdollEntry& Entry = Entries[Index];
+		if (Entry.State == ENSRagdollState::Simulating && Entry.Character.IsValid())
+		{
+			const float DistSq = FVector::DistSquared(Entry.Character->GetActorLocation(), ViewLocation);
+			if (DistSq > OutDistSq)
+			{
+				OutDistSq = DistSq;
+				Farthest = Index;
+			}
+		}
+	}
+	return Farthest;
+}
+
+bool UNSRagdollManager::GetViewLocation(FVector& OutLocation) const
+{
+	APlayerController* Controller = GetWorld()->GetFirstPlayerController();
+	if (Controller != nullptr && Controller->PlayerCameraManager != nullptr)
+	{
+		OutLocation = Controller->PlayerCameraManager->GetCameraLocation();
+		return true;
+	}
+	return false;
+}
+
+int32 UNSRagdollManager::CountInState(ENSRagdollState State) const
+{
+	int32 Count = 0;
+	for (const FNSRagdollEntry& Entry : Entries)
+	{
+		Count += Entry.State == State ? 1 : 0;
+	}
+	return Count;
+}
+
+void UNSRagdollManager::UpdateStats() const
+{
+	SET_DWORD_STAT(STAT_fpsNS_RagdollsSimulating, CountInState(ENSRagdollState::Simulating));
+	SET_DWORD_STAT(STAT_fpsNS_RagdollsFallback, CountInState(ENSRagdollState::Fallback));
+	SET_DWORD_STAT(STAT_fpsNS_RagdollsFrozen, CountInState(ENSRagdollState::Frozen));
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSRagdollManager.generated.h"
+
+class AfpsNSCharacter;
+
+UENUM()
+enum class ENSRagdollState : uint8
+{
+	Simulating,
+	Fallback,
+	Frozen
+};
+
+/**   ü ϳ */
+USTRUCT()
+struct FNSRagdollEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<AfpsNSCharacter> Character;
+
+	ENSRagdollState State = ENSRagdollState::Simulating;
+	float StartTime = 0.0f;
+	float SettledTime = -1.0f;
+};
+
+/**
+ * ÿ  ùķ̼ϴ ׵  Ѵ.
+ * þ߿  ü 켱 ùķ̼ϰ,  Ѵ ü  ִϸ̼ Ѵ.
+ * ߰ų ð  ׵   󸰴.
+ */
+UCLASS(config=Game)
+class FPSNS_API UNSRagdollManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RequestRagdoll(AfpsNSCharacter* Character);
+
+	// ̳ ı  ̻  ʴ´
+	void ReleaseRagdoll(AfpsNSCharacter* Character);
+
+	/** ÿ ùķ̼  ִ ִ ׵  */
+	UPROPERTY(Config)
+	int32 MaxSimulatingRagdolls = 8;
+
+	/**  ð   ʾҾ 󸰴 () */
+	UPROPERTY(Config)
+	float FreezeTimeout = 5.0f;
+
+	/**  ӵ Ϸ SettleDuration  Ǹ    (cm/s) */
+	UPROPERTY(Config)
+	float SettleSpeed = 10.0f;
+
+	UPROPERTY(Config)
+	float SettleDuration = 0.5f;
+
+	UPROPERTY(Config)
+	float UpdateInterval = 0.25f;
+
+private:
+	void UpdateRagdolls();
+
+	void StartSimulation(FNSRagdollEntry& Entry);
+	void StartFallback(FNSRagdollEntry& Entry);
+	void Freeze(FNSRagdollEntry& Entry);
+
+	// þ ġ   ùķ̼  ׵
+	int32 FindFarthestSimulating(const FVector& ViewLocation, float& OutDistSq) const;
+	bool GetViewLocation(FVector& OutLocation) const;
+	int32 CountInState(ENSRagdollState State) const;
+
+	void UpdateStats() const;
+
+	UPROPERTY()
+	TArray<FNSRagdollEntry> Entries;
+
+	FTimerHandle UpdateTimer;
+};
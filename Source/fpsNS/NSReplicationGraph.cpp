@@ -0,0 +1,460 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSReplicationGraph.h"
+#include "fpsNS.h"
+#include "fpsNSCharacter.h"
+#include "fpsNSProjectile.h"
+#include "NSGameStateBase.h"
+#include "NSPlayerState.h"
+#include "NSSpawnPoint.h"
+#include "NSTeamInfo.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Traces"), STAT_fpsNS_LineOfSightTraces, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("Line Of Sight Update"), STAT_fpsNS_LineOfSightUpdate, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("Line Of Sight Gather"), STAT_fpsNS_LineOfSightGather, STATGROUP_fpsNS);
+
+//////////////////////////////////////////////////////////////////////////
+// UNSReplicationGraphNode_TeamPlayerStates
+
+void UNSReplicationGraphNode_TeamPlayerStates::PrepareForReplication()
+{
+	for (FActorRepListRefView& TeamList : TeamLists)
+	{
+		TeamList.Reset();
+	}
+
+	//   ٲ  Ƿ   ٽ . ÷̾ ŭ 
+	const ANSGameStateBase* GameState = GetWorld()->GetGameState<ANSGameStateBase>();
+	if (GameState == nullptr)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < int32(ETeam::MAX); ++Index)
+	{
+		if (ANSTeamInfo* TeamInfo = GameState->GetTeamInfo(ETeam(Index)))
+		{
+			TeamLists[Index].Add(TeamInfo);
+		}
+	}
+
+	for (APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		const ANSPlayerState* NSPlayerState = Cast<ANSPlayerState>(PlayerState);
+		if (NSPlayerState != nullptr && NSPlayerState->GetTeam() < ETeam::MAX)
+		{
+			TeamLists[int32(NSPlayerState->GetTeam())].Add(PlayerState);
+		}
+	}
+}
+
+void UNSReplicationGraphNode_TeamPlayerStates::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	const APlayerController* Controller = Params.ConnectionManager.NetConnection ? Params.ConnectionManager.NetConnection->PlayerController : nullptr;
+	const ANSPlayerState* NSPlayerState = Controller ? Controller->GetPlayerState<ANSPlayerState>() : nullptr;
+	if (NSPlayerState == nullptr || NSPlayerState->GetTeam() >= ETeam::MAX)
+	{
+		return;
+	}
+
+	const FActorRepListRefView& TeamList = TeamLists[int32(NSPlayerState->GetTeam())];
+	if (TeamList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(TeamList);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UNSReplicationGraphNode_LineOfSight
+
+void UNSReplicationGraphNode_LineOfSight::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AfpsNSCharacter* Character = Cast<AfpsNSCharacter>(ActorInfo.Actor);
+	if (Character == nullptr || SlotMap.Contains(Character))
+	{
+		return;
+	}
+
+	int32 Slot = Characters.Find(nullptr);
+	if (Slot == INDEX_NONE)
+	{
+		Slot = Characters.Add(Character);
+	}
+	else
+	{
+		Characters[Slot] = Character;
+	}
+	SlotMap.Add(Character, Slot);
+
+	if (Characters.Num() > Stride)
+	{
+		GrowMatrix(FMath::Max(16, Stride * 2));
+	}
+}
+
+bool UNSReplicationGraphNode_LineOfSight::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	int32 Slot = INDEX_NONE;
+	if (!SlotMap.RemoveAndCopyValue(ActorInfo.Actor, Slot))
+	{
+		return false;
+	}
+
+	// ڸ ٽ    ĳ   ʰ 
+	Characters[Slot] = nullptr;
+	for (int32 Other = 0; Other < Stride; ++Other)
+	{
+		LastVisibleTime[FMath::Min(Slot, Other) * Stride + FMath::Max(Slot, Other)] = -MAX_flt;
+	}
+	return true;
+}
+
+void UNSReplicationGraphNode_LineOfSight::NotifyResetAllNetworkActors()
+{
+	Characters.Reset();
+	SlotMap.Reset();
+	LastVisibleTime.Reset();
+	Stride = 0;
+	PairCursor = 0;
+}
+
+void UNSReplicationGraphNode_LineOfSight::GrowMatrix(int32 NewStride)
+{
+	TArray<float> NewTimes;
+	NewTimes.Init(-MAX_flt, NewStride * NewStride);
+	for (int32 A = 0; A < Stride; ++A)
+	{
+		for (int32 B = A + 1; B < Stride; ++B)
+		{
+			NewTimes[A * NewStride + B] = LastVisibleTime[A * Stride + B];
+		}
+	}
+
+	LastVisibleTime = MoveTemp(NewTimes);
+	Stride = NewStride;
+	PairCursor = 0;
+}
+
+void UNSReplicationGraphNode_LineOfSight::PrepareForReplication()
+{
+	if (Stride == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_LineOfSightUpdate);
+	CSV_SCOPED_TIMING_STAT(fpsNS, LineOfSightUpdate);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float MaxDistanceSq = FMath::Square(MaxDistance);
+	const int32 NumPairs = Stride * Stride;
+
+	// ̾ ˻ϴٰ   ų      ѱ
+	int32 Traced = 0;
+	for (int32 Visited = 0; Visited < NumPairs && Traced < TracesPerFrame; ++Visited)
+	{
+		const int32 A = PairCursor / Stride;
+		const int32 B = PairCursor % Stride;
+		PairCursor = (PairCursor + 1) % NumPairs;
+
+		// þߴ Ī  ( , ū ) ָ ˻Ѵ
+		if (B <= A || B >= Characters.Num())
+		{
+			continue;
+		}
+
+		const AfpsNSCharacter* Viewer = Characters[A];
+		const AfpsNSCharacter* Target = Characters[B];
+		if (Viewer == nullptr || Target == nullptr || Viewer->CurrentTeam == Target->CurrentTeam
+			|| Viewer->IsHidden() || Target->IsHidden()
+			|| FVector::DistSquared(Viewer->GetActorLocation(), Target->GetActorLocation()) > MaxDistanceSq)
+		{
+			continue;
+		}
+
+		++Traced;
+		if (TraceLineOfSight(Viewer, Target))
+		{
+			LastVisibleTime[A * Stride + B] = Now;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_fpsNS_LineOfSightTraces, Traced);
+}
+
+bool UNSReplicationGraphNode_LineOfSight::TraceLineOfSight(const AfpsNSCharacter* Viewer, const AfpsNSCharacter* Target) const
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(NSLineOfSight), false, Viewer);
+	Params.AddIgnoredActor(Target);
+
+	//  ̴    . ̿   ̸ 
+	const FVector ViewLocation = Viewer->GetPawnViewLocation();
+	const FVector TargetLocation = Target->GetPawnViewLocation();
+	if (!GetWorld()->LineTraceTestByChannel(ViewLocation, TargetLocation, ECC_Visibility, Params))
+	{
+		return true;
+	}
+
+	const FVector LeadLocation = TargetLocation + Target->GetVelocity() * LeadTime;
+	return LeadTime > 0.0f && !GetWorld()->LineTraceTestByChannel(ViewLocation, LeadLocation, ECC_Visibility, Params);
+}
+
+int32 UNSReplicationGraphNode_LineOfSight::FindSlot(const AActor* Character) const
+{
+	const int32* Slot = SlotMap.Find(Character);
+	return Slot ? *Slot : INDEX_NONE;
+}
+
+bool UNSReplicationGraphNode_LineOfSight::WasVisibleRecently(int32 SlotA, int32 SlotB, float Now) const
+{
+	return Now - LastVisibleTime[FMath::Min(SlotA, SlotB) * Stride + FMath::Max(SlotA, SlotB)] <= GraceTime;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UNSReplicationGraphNode_LineOfSight_ForConnection
+
+void UNSReplicationGraphNode_LineOfSight_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_LineOfSightGather);
+
+	ReplicationList.Reset();
+
+	const APlayerController* Controller = Params.ConnectionManager.NetConnection ? Params.ConnectionManager.NetConnection->PlayerController : nullptr;
+	const AfpsNSCharacter* ViewerCharacter = Controller ? Cast<AfpsNSCharacter>(Controller->GetPawn()) : nullptr;
+
+	// ׾ų  ̸ þ߷ Ÿ ʰ Ÿ 
+	const int32 ViewerSlot = ViewerCharacter && !ViewerCharacter->bIsDead ? LineOfSight->FindSlot(ViewerCharacter) : INDEX_NONE;
+
+	const FVector ViewLocation = Params.Viewers.Num() > 0 ? Params.Viewers[0].ViewLocation : FVector::ZeroVector;
+	const float CullDistanceSq = FMath::Square(CullDistance);
+	const float ProximityRadiusSq = FMath::Square(ProximityRadius);
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	const TArray<AfpsNSCharacter*>& Characters = LineOfSight->GetCharacters();
+	for (int32 Slot = 0; Slot < Characters.Num(); ++Slot)
+	{
+		AfpsNSCharacter* Character = Characters[Slot];
+		if (Character == nullptr)
+		{
+			continue;
+		}
+
+		const float DistanceSq = FVector::DistSquared(Character->GetActorLocation(), ViewLocation);
+		if (DistanceSq > CullDistanceSq)
+		{
+			continue;
+		}
+
+		const bool bRelevant = ViewerSlot == INDEX_NONE
+			|| Slot == ViewerSlot
+			|| Character->CurrentTeam == ViewerCharacter->CurrentTeam
+			|| DistanceSq <= ProximityRadiusSq
+			|| LineOfSight->WasVisibleRecently(ViewerSlot, Slot, Now);
+
+		//  ̴  Ը ٸ ӿ   󵵷 
+		const bool bHiddenTick = HiddenUpdateFrames > 0 && (Params.ReplicationFrameNum + Slot) % HiddenUpdateFrames == 0;
+
+		if (bRelevant || bHiddenTick)
+		{
+			ReplicationList.Add(Character);
+		}
+	}
+
+	if (ReplicationList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationList);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UNSReplicationGraph
+
+void UNSReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	ClassRepNodePolicies.Set(AReplicationGraphDebugActor::StaticClass(), ENSClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), ENSClassRepNodeMapping::NotRouted);
+	//     尡  Ʈ Ͽ  
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), ENSClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ANSTeamInfo::StaticClass(), ENSClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AGameStateBase::StaticClass(), ENSClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(AfpsNSCharacter::StaticClass(), bLineOfSightRelevancy ? ENSClassRepNodeMapping::LineOfSight : ENSClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AfpsNSProjectile::StaticClass(), ENSClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(ANSSpawnPoint::StaticClass(), ENSClassRepNodeMapping::Spatialize_Dormancy);
+
+	TArray<UClass*> ReplicatedClasses;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (ActorCDO == nullptr || !ActorCDO->GetIsReplicated()
+			|| Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		ReplicatedClasses.Add(Class);
+
+		//  ߰ų θ ü   θ Ģ 
+		if (ClassRepNodePolicies.Contains(Class, false))
+		{
+			continue;
+		}
+
+		const AActor* SuperCDO = Cast<AActor>(Class->GetSuperClass()->GetDefaultObject());
+		if (SuperCDO != nullptr && SuperCDO->GetIsReplicated()
+			&& SuperCDO->bAlwaysRelevant == ActorCDO->bAlwaysRelevant
+			&& SuperCDO->bOnlyRelevantToOwner == ActorCDO->bOnlyRelevantToOwner
+			&& SuperCDO->bNetUseOwnerRelevancy == ActorCDO->bNetUseOwnerRelevancy)
+		{
+			continue;
+		}
+
+		if (ActorCDO->bOnlyRelevantToOwner || ActorCDO->bNetUseOwnerRelevancy)
+		{
+			ClassRepNodePolicies.Set(Class, ENSClassRepNodeMapping::NotRouted);
+		}
+		else if (ActorCDO->bAlwaysRelevant)
+		{
+			ClassRepNodePolicies.Set(Class, ENSClassRepNodeMapping::RelevantAllConnections);
+		}
+		else
+		{
+			ClassRepNodePolicies.Set(Class, ENSClassRepNodeMapping::Spatialize_Dynamic);
+		}
+	}
+
+	FClassReplicationInfo PawnInfo;
+	PawnInfo.DistancePriorityScale = 1.0f;
+	PawnInfo.StarvationPriorityScale = 1.0f;
+	PawnInfo.ActorChannelFrameTimeout = 4;
+	PawnInfo.SetCullDistanceSquared(FMath::Square(PawnCullDistance));
+
+	//  ̴   󵵷   ä  ٽ  ʰ Ѵ
+	FClassReplicationInfo CharacterInfo = PawnInfo;
+	if (bLineOfSightRelevancy && HiddenUpdateFrames > 0)
+	{
+		CharacterInfo.ActorChannelFrameTimeout = FMath::Max<int32>(PawnInfo.ActorChannelFrameTimeout, HiddenUpdateFrames + 2);
+	}
+
+	for (UClass* Class : ReplicatedClasses)
+	{
+		if (Class->IsChildOf(AfpsNSCharacter::StaticClass()))
+		{
+			GlobalActorReplicationInfoMap.SetClassInfo(Class, CharacterInfo);
+			continue;
+		}
+
+		if (Class->IsChildOf(AfpsNSProjectile::StaticClass()))
+		{
+			GlobalActorReplicationInfoMap.SetClassInfo(Class, PawnInfo);
+			continue;
+		}
+
+		const ENSClassRepNodeMapping Policy = GetMappingPolicy(Class);
+		const bool bSpatialize = Policy == ENSClassRepNodeMapping::Spatialize_Dynamic || Policy == ENSClassRepNodeMapping::Spatialize_Dormancy;
+
+		FClassReplicationInfo ClassInfo;
+		InitClassReplicationInfo(ClassInfo, Class, bSpatialize, NetDriver->NetServerMaxTickRate);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void UNSReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = CellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	LineOfSightNode = CreateNewNode<UNSReplicationGraphNode_LineOfSight>();
+	LineOfSightNode->TracesPerFrame = LineOfSightTracesPerFrame;
+	LineOfSightNode->GraceTime = LineOfSightGraceTime;
+	LineOfSightNode->LeadTime = LineOfSightLeadTime;
+	LineOfSightNode->MaxDistance = PawnCullDistance;
+	AddGlobalGraphNode(LineOfSightNode);
+
+	AddGlobalGraphNode(CreateNewNode<UNSReplicationGraphNode_TeamPlayerStates>());
+	AddGlobalGraphNode(CreateNewNode<UReplicationGraphNode_PlayerStateFrequencyLimiter>());
+}
+
+void UNSReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// ڱ Ʈѷ  Ÿ() Ÿ  
+	AddConnectionGraphNode(CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>(), RepGraphConnection);
+
+	UNSReplicationGraphNode_LineOfSight_ForConnection* LineOfSightConnectionNode = CreateNewNode<UNSReplicationGraphNode_LineOfSight_ForConnection>();
+	LineOfSightConnectionNode->LineOfSight = LineOfSightNode;
+	LineOfSightConnectionNode->CullDistance = PawnCullDistance;
+	LineOfSightConnectionNode->ProximityRadius = LineOfSightProximity;
+	LineOfSightConnectionNode->HiddenUpdateFrames = HiddenUpdateFrames;
+	AddConnectionGraphNode(LineOfSightConnectionNode, RepGraphConnection);
+}
+
+void UNSReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case ENSClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case ENSClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case ENSClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case ENSClassRepNodeMapping::LineOfSight:
+		LineOfSightNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void UNSReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case ENSClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case ENSClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case ENSClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case ENSClassRepNodeMapping::LineOfSight:
+		LineOfSightNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void UNSReplicationGraph::SetActorNetUpdateFrequency(AActor* Actor, float NetUpdateFrequency)
+{
+	FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor);
+	if (GlobalInfo != nullptr && NetUpdateFrequency > 0.0f)
+	{
+		GlobalInfo->Settings.ReplicationPeriodFrame = uint16(FMath::Clamp(FMath::RoundToInt(NetDriver->NetServerMaxTickRate / NetUpdateFrequency), 1, 255));
+	}
+}
+
+ENSClassRepNodeMapping UNSReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	const ENSClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class);
+	return Policy ? *Policy : ENSClassRepNodeMapping::NotRouted;
+}
@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fpsNSGameMode.h"
+#include "ReplicationGraph.h"
+#include "NSReplicationGraph.generated.h"
+
+class ANSPlayerState;
+class AfpsNSCharacter;
+
+/**  Ŭ    */
+enum class ENSClassRepNodeMapping : uint8
+{
+	NotRouted,					// Ằ (Ʈѷ,  Ÿ)  尡 óѴ
+	RelevantAllConnections,		//  ῡ ׻ 
+	Spatialize_Dynamic,			// ڿ ְ   ġ Ѵ
+	Spatialize_Dormancy,		// ޸ ߿ ,    ڿ д
+	LineOfSight,				// þ 尡 Ḷ ̴  
+};
+
+/**
+ *  ÷̾ Ʈ ڱ   ( ü)   .
+ * ٸ  ÷̾ Ʈ   尡    , ٸ     ʴ´.
+ */
+UCLASS()
+class FPSNS_API UNSReplicationGraphNode_TeamPlayerStates : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override {}
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+	virtual void NotifyResetAllNetworkActors() override {}
+
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+	FActorRepListRefView TeamLists[int32(ETeam::MAX)];
+};
+
+/**
+ *  ٸ  ĳ  þ߸  ӿ  Ʈ̽Ѵ.
+ * Ӹ TracesPerFrame ָ ˻ϰ   ð Ѵ.
+ */
+UCLASS()
+class FPSNS_API UNSReplicationGraphNode_LineOfSight : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+
+	virtual void PrepareForReplication() override;
+
+	//    ʴ´. Ằ 尡  д´
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override {}
+
+	int32 FindSlot(const AActor* Character) const;
+
+	//   GraceTime ȿ  
+	bool WasVisibleRecently(int32 SlotA, int32 SlotB, float Now) const;
+
+	const TArray<AfpsNSCharacter*>& GetCharacters() const { return Characters; }
+
+	int32 TracesPerFrame = 512;
+	float GraceTime = 0.5f;
+	float LeadTime = 0.2f;
+	float MaxDistance = 15000.0f;
+
+private:
+	bool TraceLineOfSight(const AfpsNSCharacter* Viewer, const AfpsNSCharacter* Target) const;
+
+	//    ũ⸦   Ű Ű
+	void GrowMatrix(int32 NewStride);
+
+	//  ڸ nullptr
+	UPROPERTY()
+	TArray<AfpsNSCharacter*> Characters;
+
+	TMap<const AActor*, int32> SlotMap;
+
+	//   ( , ū )   ð
+	TArray<float> LastVisibleTime;
+	int32 Stride = 0;
+	int32 PairCursor = 0;
+};
+
+/**
+ * Ḷ ̴  Ʊ ĳ͸ .
+ *  ̴  HiddenUpdateFrames ӿ   , 0̸  ʴ´.
+ */
+UCLASS()
+class FPSNS_API UNSReplicationGraphNode_LineOfSight_ForConnection : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override {}
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+	virtual void NotifyResetAllNetworkActors() override {}
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	UPROPERTY()
+	UNSReplicationGraphNode_LineOfSight* LineOfSight;
+
+	float CullDistance = 15000.0f;
+	float ProximityRadius = 1000.0f;
+	int32 HiddenUpdateFrames = 15;
+
+private:
+	FActorRepListRefView ReplicationList;
+};
+
+/**
+ * fpsNS   ׷.
+ * ĳʹ þ , ü  ڷ,  Ʈ ׻  , ÷̾ Ʈ      .
+ * ⺻  ̹ó Ḷ  ͸  ʴ´.
+ */
+UCLASS(transient, config=Game)
+class FPSNS_API UNSReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	/**  ϳ  ֱ⸦ Ŭ   NetUpdateFrequency Ѵ */
+	void SetActorNetUpdateFrequency(AActor* Actor, float NetUpdateFrequency);
+
+	/**    ũ (cm) */
+	UPROPERTY(Config)
+	float CellSize = 10000.0f;
+
+	/**  .  ּ ǥ ۰ ´ */
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-150000.0f, -150000.0f);
+
+	/** ĳͿ ü  Ÿ (cm) */
+	UPROPERTY(Config)
+	float PawnCullDistance = 15000.0f;
+
+	/** ĳ͸   þ  .     󵵷θ  */
+	UPROPERTY(Config)
+	bool bLineOfSightRelevancy = true;
+
+	/** Ӹ ˻ ĳ   */
+	UPROPERTY(Config)
+	int32 LineOfSightTracesPerFrame = 512;
+
+	/**     ð  ̴   () */
+	UPROPERTY(Config)
+	float LineOfSightGraceTime = 0.5f;
+
+	/**  ӵ  ðŭ  . ̸   ʰ Ÿ ʰ Ѵ () */
+	UPROPERTY(Config)
+	float LineOfSightLeadTime = 0.2f;
+
+	/**  Ÿ   þ߿   (cm) */
+	UPROPERTY(Config)
+	float LineOfSightProximity = 1000.0f;
+
+	/**  ̴   ֱ (). 0̸  ʰ ä ݴ´ */
+	UPROPERTY(Config)
+	int32 HiddenUpdateFrames = 15;
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+
+	UPROPERTY()
+	UNSReplicationGraphNode_LineOfSight* LineOfSightNode;
+
+private:
+	ENSClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	TClassMap<ENSClassRepNodeMapping> ClassRepNodePolicies;
+};
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSShotEvents.h"
+#include "fpsNSCharacter.h"
+
+void FNSShotEvent::PostReplicatedAdd(const FNSShotEventArray& InArraySerializer)
+{
+	// Ͱ ó      ߻  ʴ´
+	if (InArraySerializer.Owner != nullptr && InArraySerializer.Owner->HasActorBegunPlay())
+	{
+		InArraySerializer.Owner->PlayShotEffects(*this);
+	}
+}
+
+void FNSShotEvent::PostReplicatedChange(const FNSShotEventArray& InArraySerializer)
+{
+	PostReplicatedAdd(InArraySerializer);
+}
+
+void FNSShotEventArray::AddShot(uint8 Sequence, const FVector& Muzzle, const FVector& HitPoint)
+{
+	FNSShotEvent* Event = nullptr;
+	if (Items.Num() < Capacity)
+	{
+		Event = &Items.AddDefaulted_GetRef();
+	}
+	else
+	{
+		Event = &Items[NextSlot];
+	}
+	NextSlot = (NextSlot + 1) % Capacity;
+
+	Event->Sequence = Sequence;
+	Event->Muzzle = Muzzle;
+	Event->HitPoint = HitPoint;
+	MarkItemDirty(*Event);
+}
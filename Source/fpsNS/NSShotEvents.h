@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "NSShotEvents.generated.h"
+
+class AfpsNSCharacter;
+
+/** Ŭ̾Ʈ  ߻   ڽƽ  */
+USTRUCT()
+struct FNSShotEvent : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint8 Sequence = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize Muzzle;
+
+	UPROPERTY()
+	FVector_NetQuantize HitPoint;
+
+	void PostReplicatedAdd(const struct FNSShotEventArray& InArraySerializer);
+	void PostReplicatedChange(const struct FNSShotEventArray& InArraySerializer);
+};
+
+/**
+ * ĳͺ ߻ ̺Ʈ  .    Ʈ ̿  ߻ ϳ Ÿ 
+ * Ϲ  Ģ  ȴ.
+ */
+USTRUCT()
+struct FNSShotEventArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	static constexpr int32 Capacity = 8;
+
+	UPROPERTY()
+	TArray<FNSShotEvent> Items;
+
+	// νϽ PostInitializeComponents Ѵ. CDO Ű   ʰ Transient
+	UPROPERTY(NotReplicated, Transient)
+	AfpsNSCharacter* Owner = nullptr;
+
+	//     ߻縦 Ѵ
+	void AddShot(uint8 Sequence, const FVector& Muzzle, const FVector& HitPoint);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FNSShotEvent, FNSShotEventArray>(Items, DeltaParms, *this);
+	}
+
+private:
+	int32 NextSlot = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FNSShotEventArray> : public TStructOpsTypeTraitsBase2<FNSShotEventArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
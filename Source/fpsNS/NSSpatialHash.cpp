@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSSpatialHash.h"
+
+FNSSpatialHash::FNSSpatialHash(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+{
+}
+
+void FNSSpatialHash::SetCellSize(float InCellSize)
+{
+	check(Cells.Num() == 0);
+	CellSize = FMath::Max(InCellSize, 1.0f);
+}
+
+void FNSSpatialHash::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+}
+
+void FNSSpatialHash::Update(int32 Id, const FVector& Location, int32 Tag)
+{
+	if (Id >= Entries.Num())
+	{
+		Entries.SetNum(Id + 1);
+	}
+
+	FEntry& Entry = Entries[Id];
+	const FIntPoint Cell = GetCell(Location);
+
+	if (!Entry.bValid)
+	{
+		Cells.FindOrAdd(Cell).Add(Id);
+		Entry.bValid = true;
+	}
+	else if (Entry.Cell != Cell)
+	{
+		TArray<int32>& OldBucket = Cells.FindChecked(Entry.Cell);
+		OldBucket.RemoveSingleSwap(Id, false);
+		if (OldBucket.Num() == 0)
+		{
+			Cells.Remove(Entry.Cell);
+		}
+		Cells.FindOrAdd(Cell).Add(Id);
+	}
+
+	Entry.Location = Location;
+	Entry.Cell = Cell;
+	Entry.Tag = Tag;
+}
+
+void FNSSpatialHash::Remove(int32 Id)
+{
+	if (!Entries.IsValidIndex(Id) || !Entries[Id].bValid)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[Id];
+	TArray<int32>& Bucket = Cells.FindChecked(Entry.Cell);
+	Bucket.RemoveSingleSwap(Id, false);
+	if (Bucket.Num() == 0)
+	{
+		Cells.Remove(Entry.Cell);
+	}
+	Entry.bValid = false;
+}
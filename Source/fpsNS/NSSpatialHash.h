@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * XY     ؽ. ׸ ȣڰ  Id Ѵ.
+ * ġ   ٲ  Ŷ űǷ  ƽ ȣص δ.
+ */
+struct FPSNS_API FNSSpatialHash
+{
+	explicit FNSSpatialHash(float InCellSize = 3000.0f);
+
+	//    ٲ  ִ
+	void SetCellSize(float InCellSize);
+	float GetCellSize() const { return CellSize; }
+
+	void Reset();
+
+	// ó  Id ߰Ѵ. Tag ȣڰ   ( )
+	void Update(int32 Id, const FVector& Location, int32 Tag);
+	void Remove(int32 Id);
+
+	// ݰ  ׸񸶴 Func(Id, Location, Tag, DistSquared) ȣѴ
+	template<typename FuncType>
+	void ForEachInRadius(const FVector& Center, float Radius, FuncType&& Func) const
+	{
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+		const float RadiusSq = Radius * Radius;
+
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+			{
+				const TArray<int32>* Bucket = Cells.Find(FIntPoint(CellX, CellY));
+				if (Bucket == nullptr)
+				{
+					continue;
+				}
+
+				for (int32 Id : *Bucket)
+				{
+					const FEntry& Entry = Entries[Id];
+					const float DistSq = FVector::DistSquared(Entry.Location, Center);
+					if (DistSq <= RadiusSq)
+					{
+						Func(Id, Entry.Location, Entry.Tag, DistSq);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	struct FEntry
+	{
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 Tag = 0;
+		bool bValid = false;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	float CellSize;
+	TArray<FEntry> Entries;
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
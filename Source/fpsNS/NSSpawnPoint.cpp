@@ -2,12 +2,21 @@
 
 
 #include "NSSpawnPoint.h"
+#include "NSSpawnRegistry.h"
+#include "fpsNS.h"
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Point Overlaps"), STAT_fpsNS_SpawnPointOverlaps, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("Spawn Point Overlap"), STAT_fpsNS_SpawnPointOverlap, STATGROUP_fpsNS);
 
 // Sets default values
 ANSSpawnPoint::ANSSpawnPoint()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	//  ´  ̺Ʈθ Ѵ
+	PrimaryActorTick.bCanEverTick = false;
+
+	//    Ʈ  ѵ ó ޸Ѵ
+	NetDormancy = DORM_Initial;
 
 	SpawnCapsule = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Capsule"));
 	SpawnCapsule->SetCollisionProfileName("OverlapAllDynamic");
@@ -18,50 +27,80 @@ ANSSpawnPoint::ANSSpawnPoint()
 	OnActorEndOverlap.AddDynamic(this, &ANSSpawnPoint::ActorEndOverlaps);
 }
 
+void ANSSpawnPoint::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	//   BeginPlay  ϵǵ ⼭ Ѵ
+	if (ROLE_Authority == GetLocalRole())
+	{
+		if (UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>())
+		{
+			Registry->RegisterSpawnPoint(this);
+		}
+	}
+}
+
 // Called when the game starts or when spawned
 void ANSSpawnPoint::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	//   ̹  ִ ͸   ݿѴ
+	if (ROLE_Authority == GetLocalRole())
+	{
+		SpawnCapsule->UpdateOverlaps();
+	}
 }
 
-// Called every frame
-void ANSSpawnPoint::Tick(float DeltaTime)
+void ANSSpawnPoint::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-	SpawnCapsule->UpdateOverlaps();
+	if (UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>())
+	{
+		Registry->UnregisterSpawnPoint(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANSSpawnPoint::OnConstruction(const FTransform& Transform)
 {
-	if (Team == ETeam::RED_TEAM)
-	{
-		SpawnCapsule->ShapeColor = FColor(255, 0, 0);
-	}
-	else // (Team = ETeam::BLUE_TEAM)
-	{
-		SpawnCapsule->ShapeColor = FColor(0, 0, 255);
-	}
+	SpawnCapsule->ShapeColor = (GetTeamColor(Team) * 2.0f).ToFColor(true);
 }
 
 void ANSSpawnPoint::ActorBeginOverlaps(AActor* OverlappedActor, AActor* OtherActor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_SpawnPointOverlap);
+	INC_DWORD_STAT(STAT_fpsNS_SpawnPointOverlaps);
+
 	if (ROLE_Authority == GetLocalRole())
 	{
-		if (OverlappingActors.Find(OtherActor) == INDEX_NONE)
+		const bool bWasBlocked = GetBlocked();
+		OverlappingActors.AddUnique(OtherActor);
+
+		if (!bWasBlocked)
 		{
-			OverlappingActors.Add(OtherActor);
+			if (UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>())
+			{
+				Registry->SetSpawnPointBlocked(this, true);
+			}
 		}
 	}
 }
 
 void ANSSpawnPoint::ActorEndOverlaps(AActor* OverlappedActor, AActor* OtherActor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_SpawnPointOverlap);
+	INC_DWORD_STAT(STAT_fpsNS_SpawnPointOverlaps);
+
 	if (ROLE_Authority == GetLocalRole())
 	{
-		if (OverlappingActors.Find(OtherActor) == INDEX_NONE)
+		if (OverlappingActors.Remove(OtherActor) > 0 && !GetBlocked())
 		{
-			OverlappingActors.Remove(OtherActor);
+			if (UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>())
+			{
+				Registry->SetSpawnPointBlocked(this, false);
+			}
 		}
 	}
 }
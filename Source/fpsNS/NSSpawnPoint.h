@@ -17,11 +17,12 @@ public:
 	// Sets default values for this actor's properties
 	ANSSpawnPoint();
 
+	virtual void PostInitializeComponents() override;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 
@@ -31,7 +32,7 @@ public:
 	UFUNCTION()
 	void ActorEndOverlaps(AActor* OverlappedActor, AActor* OtherActor);
 
-	bool GetBlocked()
+	bool GetBlocked() const
 	{
 		return OverlappingActors.Num() != 0;
 	}
@@ -41,6 +42,9 @@ public:
 
 	bool isTaken = false;
 
+	// UNSSpawnRegistry ȿ ε
+	int32 RegistryIndex = INDEX_NONE;
+
 protected:
 	UCapsuleComponent* SpawnCapsule;
 	TArray<class AActor*> OverlappingActors;
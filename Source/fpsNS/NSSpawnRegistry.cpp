@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSSpawnRegistry.h"
+#include "NSSpawnPoint.h"
+
+void UNSSpawnRegistry::Deinitialize()
+{
+	TeamSpawnPoints.Reset();
+	WarnedTeams.Reset();
+	Super::Deinitialize();
+}
+
+void UNSSpawnRegistry::RegisterSpawnPoint(ANSSpawnPoint* SpawnPoint)
+{
+	FNSTeamSpawnPoints& TeamPoints = TeamSpawnPoints.FindOrAdd(SpawnPoint->Team);
+	if (!TeamPoints.Points.Contains(SpawnPoint))
+	{
+		SpawnPoint->RegistryIndex = TeamPoints.Points.Add(SpawnPoint);
+		TeamPoints.Free.Add(!SpawnPoint->GetBlocked());
+
+		if (!SpawnPoint->GetBlocked())
+		{
+			OnSpawnPointFreed.Broadcast(SpawnPoint->Team);
+		}
+	}
+}
+
+void UNSSpawnRegistry::UnregisterSpawnPoint(ANSSpawnPoint* SpawnPoint)
+{
+	FNSTeamSpawnPoints* TeamPoints = TeamSpawnPoints.Find(SpawnPoint->Team);
+	if (TeamPoints == nullptr || !TeamPoints->Points.IsValidIndex(SpawnPoint->RegistryIndex))
+	{
+		return;
+	}
+
+	//   ڸ Ű 迭  Ѵ
+	const int32 Index = SpawnPoint->RegistryIndex;
+	const int32 LastIndex = TeamPoints->Points.Num() - 1;
+	if (Index != LastIndex)
+	{
+		TeamPoints->Points[Index] = TeamPoints->Points[LastIndex];
+		TeamPoints->Points[Index]->RegistryIndex = Index;
+		TeamPoints->Free[Index] = TeamPoints->Free[LastIndex];
+	}
+	TeamPoints->Points.RemoveAt(LastIndex);
+	TeamPoints->Free.RemoveAt(LastIndex);
+	SpawnPoint->RegistryIndex = INDEX_NONE;
+}
+
+void UNSSpawnRegistry::SetSpawnPointBlocked(ANSSpawnPoint* SpawnPoint, bool bBlocked)
+{
+	FNSTeamSpawnPoints* TeamPoints = TeamSpawnPoints.Find(SpawnPoint->Team);
+	if (TeamPoints != nullptr && TeamPoints->Points.IsValidIndex(SpawnPoint->RegistryIndex))
+	{
+		TeamPoints->Free[SpawnPoint->RegistryIndex] = !bBlocked;
+
+		if (!bBlocked)
+		{
+			OnSpawnPointFreed.Broadcast(SpawnPoint->Team);
+		}
+	}
+}
+
+bool UNSSpawnRegistry::HasSpawnPoints(ETeam Team) const
+{
+	const FNSTeamSpawnPoints* TeamPoints = TeamSpawnPoints.Find(Team);
+	return TeamPoints != nullptr && TeamPoints->Points.Num() > 0;
+}
+
+const FNSTeamSpawnPoints* UNSSpawnRegistry::FindTeamSpawnPoints(ETeam Team) const
+{
+	const FNSTeamSpawnPoints* TeamPoints = TeamSpawnPoints.Find(Team);
+	if (TeamPoints != nullptr && TeamPoints->Points.Num() > 0)
+	{
+		return TeamPoints;
+	}
+
+	if (!WarnedTeams.Contains(Team))
+	{
+		WarnedTeams.Add(Team);
+		UE_LOG(LogTemp, Warning, TEXT("No spawn points for team %d in %s, spawning at other teams' points"),
+			int32(Team), *GetWorld()->GetMapName());
+	}
+	return nullptr;
+}
+
+ANSSpawnPoint* UNSSpawnRegistry::FindFreeSpawnPoint(ETeam Team) const
+{
+	if (const FNSTeamSpawnPoints* TeamPoints = FindTeamSpawnPoints(Team))
+	{
+		const int32 Index = TeamPoints->Free.Find(true);
+		return Index != INDEX_NONE ? TeamPoints->Points[Index] : nullptr;
+	}
+
+	//    ʿ    ̵ . ƴϸ ٷ   ʴ´
+	for (const TPair<ETeam, FNSTeamSpawnPoints>& Pair : TeamSpawnPoints)
+	{
+		const int32 Index = Pair.Value.Free.Find(true);
+		if (Index != INDEX_NONE)
+		{
+			return Pair.Value.Points[Index];
+		}
+	}
+	return nullptr;
+}
+
+void UNSSpawnRegistry::GetFreeSpawnPoints(ETeam Team, TArray<ANSSpawnPoint*>& OutSpawnPoints) const
+{
+	OutSpawnPoints.Reset();
+
+	const FNSTeamSpawnPoints* TeamPoints = FindTeamSpawnPoints(Team);
+	for (const TPair<ETeam, FNSTeamSpawnPoints>& Pair : TeamSpawnPoints)
+	{
+		if (TeamPoints != nullptr && &Pair.Value != TeamPoints)
+		{
+			continue;
+		}
+
+		for (TConstSetBitIterator<> It(Pair.Value.Free); It; ++It)
+		{
+			OutSpawnPoints.Add(Pair.Value.Points[It.GetIndex()]);
+		}
+	}
+}
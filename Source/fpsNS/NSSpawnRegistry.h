@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fpsNSGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSSpawnRegistry.generated.h"
+
+class ANSSpawnPoint;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FNSOnSpawnPointFreed, ETeam);
+
+/**      ִ  Ʈ */
+USTRUCT()
+struct FNSTeamSpawnPoints
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<ANSSpawnPoint*> Points;
+
+	TBitArray<> Free;
+};
+
+/**
+ *    ¸  ̺Ʈ ϰ    Ʈ Ѵ.
+ *   ƽ ʰ   Ʈ¸ д´.
+ */
+UCLASS()
+class FPSNS_API UNSSpawnRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterSpawnPoint(ANSSpawnPoint* SpawnPoint);
+	void UnregisterSpawnPoint(ANSSpawnPoint* SpawnPoint);
+
+	//    ΰ ٲ  ȣȴ
+	void SetSpawnPointBlocked(ANSSpawnPoint* SpawnPoint, bool bBlocked);
+
+	//   ִ ù  .  nullptr
+	// ʿ     ϳ  ٸ    
+	ANSSpawnPoint* FindFreeSpawnPoint(ETeam Team) const;
+
+	// ʿ    ϳ ϵ ִ.  ٸ    
+	bool HasSpawnPoints(ETeam Team) const;
+
+	//   ִ    
+	void GetFreeSpawnPoints(ETeam Team, TArray<ANSSpawnPoint*>& OutSpawnPoints) const;
+
+	//      ˸
+	FNSOnSpawnPointFreed OnSpawnPointFreed;
+
+private:
+	//       ,  ϰ nullptr
+	const FNSTeamSpawnPoints* FindTeamSpawnPoints(ETeam Team) const;
+
+	UPROPERTY()
+	TMap<ETeam, FNSTeamSpawnPoints> TeamSpawnPoints;
+
+	//   ٰ ̹  
+	mutable TSet<ETeam> WarnedTeams;
+};
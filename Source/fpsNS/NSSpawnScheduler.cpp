@@ -0,0 +1,237 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSSpawnScheduler.h"
+#include "fpsNS.h"
+#include "fpsNSCharacter.h"
+#include "NSSpawnPoint.h"
+#include "NSSpawnRegistry.h"
+#include "NSSpawnSelector.h"
+#include "NSPawnPool.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawns"), STAT_fpsNS_Spawns, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Backoffs"), STAT_fpsNS_SpawnBackoffs, STATGROUP_fpsNS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawns Pending"), STAT_fpsNS_SpawnsPending, STATGROUP_fpsNS);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Spawns/sec"), STAT_fpsNS_SpawnsPerSec, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("Spawn Scheduler"), STAT_fpsNS_SpawnScheduler, STATGROUP_fpsNS);
+
+namespace
+{
+	struct FOlderRequest
+	{
+		bool operator()(const FNSSpawnRequest& A, const FNSSpawnRequest& B) const
+		{
+			return A.RequestTime < B.RequestTime;
+		}
+	};
+
+	struct FEarlierAttempt
+	{
+		bool operator()(const FNSSpawnRequest& A, const FNSSpawnRequest& B) const
+		{
+			return A.NextAttemptTime < B.NextAttemptTime;
+		}
+	};
+}
+
+void UNSSpawnScheduler::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency(UNSSpawnRegistry::StaticClass());
+	Collection.InitializeDependency(UNSSpawnSelector::StaticClass());
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UNSSpawnScheduler::OnWorldPostActorTick);
+	if (UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>())
+	{
+		SpawnPointFreedHandle = Registry->OnSpawnPointFreed.AddUObject(this, &UNSSpawnScheduler::OnSpawnPointFreed);
+	}
+}
+
+void UNSSpawnScheduler::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	if (UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>())
+	{
+		Registry->OnSpawnPointFreed.Remove(SpawnPointFreedHandle);
+	}
+
+	ReadyRequests.Reset();
+	BackoffRequests.Reset();
+	Pending.Reset();
+	Super::Deinitialize();
+}
+
+void UNSSpawnScheduler::RequestSpawn(AfpsNSCharacter* Character)
+{
+	if (Character == nullptr || Pending.Contains(Character))
+	{
+		return;
+	}
+
+	FNSSpawnRequest Request;
+	Request.Character = Character;
+	Request.Team = Character->CurrentTeam;
+	Request.RequestTime = GetWorld()->GetTimeSeconds();
+	Request.NextAttemptTime = Request.RequestTime;
+
+	ReadyRequests.HeapPush(Request, FOlderRequest());
+	Pending.Add(Character);
+}
+
+void UNSSpawnScheduler::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// ⿭  ־ ʴ   Ѵ
+	SpawnRate.Tick(DeltaSeconds);
+	SET_FLOAT_STAT(STAT_fpsNS_SpawnsPerSec, SpawnRate.GetRate());
+	CSV_CUSTOM_STAT(fpsNS, SpawnsPerSec, SpawnRate.GetRate(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(fpsNS, SpawnsPending, GetNumPending(), ECsvCustomStatOp::Set);
+
+	if (ReadyRequests.Num() == 0 && BackoffRequests.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_SpawnScheduler);
+	CSV_SCOPED_TIMING_STAT(fpsNS, SpawnScheduler);
+
+	const float Now = World->GetTimeSeconds();
+
+	// õ ð  û ó ⿭ ű
+	while (BackoffRequests.Num() > 0 && BackoffRequests.HeapTop().NextAttemptTime <= Now)
+	{
+		FNSSpawnRequest Request;
+		BackoffRequests.HeapPop(Request, FEarlierAttempt(), false);
+		ReadyRequests.HeapPush(Request, FOlderRequest());
+	}
+
+	int32 Budget = SpawnsPerFrame;
+	while (Budget > 0 && ReadyRequests.Num() > 0)
+	{
+		FNSSpawnRequest Request;
+		ReadyRequests.HeapPop(Request, FOlderRequest(), false);
+
+		AfpsNSCharacter* Character = Request.Character.Get();
+		if (Character == nullptr)
+		{
+			Pending.Remove(Request.Character);
+			continue;
+		}
+
+		if (TrySpawn(Request))
+		{
+			Pending.Remove(Request.Character);
+			RecordWaitTime(Now - Request.RequestTime);
+			INC_DWORD_STAT(STAT_fpsNS_Spawns);
+			SpawnRate.Add();
+			--Budget;
+		}
+		else
+		{
+			Request.Backoff = Request.Backoff > 0.0f ? FMath::Min(Request.Backoff * 2.0f, MaxBackoff) : InitialBackoff;
+			Request.NextAttemptTime = Now + Request.Backoff;
+			BackoffRequests.HeapPush(Request, FEarlierAttempt());
+			INC_DWORD_STAT(STAT_fpsNS_SpawnBackoffs);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_fpsNS_SpawnsPending, GetNumPending());
+}
+
+void UNSSpawnScheduler::OnSpawnPointFreed(ETeam Team)
+{
+	// ڱ           ִ
+	const UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>();
+
+	bool bWoke = false;
+	for (int32 Index = BackoffRequests.Num() - 1; Index >= 0; --Index)
+	{
+		const ETeam RequestTeam = BackoffRequests[Index].Team;
+		if (RequestTeam == Team || (Registry != nullptr && !Registry->HasSpawnPoints(RequestTeam)))
+		{
+			ReadyRequests.HeapPush(BackoffRequests[Index], FOlderRequest());
+			BackoffRequests.RemoveAtSwap(Index, 1, false);
+			bWoke = true;
+		}
+	}
+
+	if (bWoke)
+	{
+		BackoffRequests.Heapify(FEarlierAttempt());
+	}
+}
+
+bool UNSSpawnScheduler::TrySpawn(const FNSSpawnRequest& Request)
+{
+	// Լ     
+	UNSSpawnSelector* Selector = GetWorld()->GetSubsystem<UNSSpawnSelector>();
+	ANSSpawnPoint* SpawnPoint = Selector ? Selector->SelectSpawnPoint(Request.Team) : nullptr;
+	if (SpawnPoint == nullptr)
+	{
+		return false;
+	}
+
+	// ħ ̺Ʈ   ٷ ϵǾ    û ٸ  ޴´
+	UNSPawnPool* Pool = GetWorld()->GetSubsystem<UNSPawnPool>();
+	if (Pool != nullptr)
+	{
+		Pool->ActivatePawn(Request.Character.Get(), SpawnPoint->GetActorLocation());
+	}
+	else
+	{
+		Request.Character->SetActorLocation(SpawnPoint->GetActorLocation());
+	}
+	return true;
+}
+
+void UNSSpawnScheduler::RecordWaitTime(float WaitTime)
+{
+	if (WaitSamples.Num() < MaxWaitSamples)
+	{
+		WaitSamples.Add(WaitTime);
+	}
+	else
+	{
+		WaitSamples[NextWaitSample] = WaitTime;
+		NextWaitSample = (NextWaitSample + 1) % MaxWaitSamples;
+	}
+}
+
+float UNSSpawnScheduler::GetWaitPercentile(float Percentile) const
+{
+	if (WaitSamples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	TArray<float> Sorted = WaitSamples;
+	Sorted.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile / 100.0f * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Index];
+}
+
+#if !UE_BUILD_SHIPPING
+static void LogSpawnStats(const TArray<FString>& Args, UWorld* World)
+{
+	UNSSpawnScheduler* Scheduler = World ? World->GetSubsystem<UNSSpawnScheduler>() : nullptr;
+	if (Scheduler == nullptr)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Time to spawn: p50 %.3fs, p90 %.3fs, p99 %.3fs, max %.3fs (%d pending)"),
+		Scheduler->GetWaitPercentile(50.0f), Scheduler->GetWaitPercentile(90.0f),
+		Scheduler->GetWaitPercentile(99.0f), Scheduler->GetWaitPercentile(100.0f), Scheduler->GetNumPending());
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSpawnStats(
+	TEXT("fpsNS.SpawnStats"),
+	TEXT("Logs time-to-spawn percentiles over the last 512 spawns."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&LogSpawnStats));
+#endif
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fpsNS.h"
+#include "fpsNSGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSSpawnScheduler.generated.h"
+
+class AfpsNSCharacter;
+
+/**  ٸ ĳ ϳ */
+struct FNSSpawnRequest
+{
+	TWeakObjectPtr<AfpsNSCharacter> Character;
+	ETeam Team = ETeam::BLUE_TEAM;
+	float RequestTime = 0.0f;
+	float NextAttemptTime = 0.0f;
+	float Backoff = 0.0f;
+};
+
+/**
+ *  û  ٸ  óϴ ٷ.
+ * Ӵ   ϰ,    û  õ  ø.
+ *    ش   û ٷ .
+ */
+UCLASS(config=Game)
+class FPSNS_API UNSSpawnScheduler : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// ̹  ̸ Ѵ
+	void RequestSpawn(AfpsNSCharacter* Character);
+
+	int32 GetNumPending() const { return ReadyRequests.Num() + BackoffRequests.Num(); }
+
+	// ֱ   ð  ()
+	float GetWaitPercentile(float Percentile) const;
+
+	/** Ӵ ִ   */
+	UPROPERTY(Config)
+	int32 SpawnsPerFrame = 4;
+
+	/** ù õ  ().    谡 ȴ */
+	UPROPERTY(Config)
+	float InitialBackoff = 0.1f;
+
+	UPROPERTY(Config)
+	float MaxBackoff = 2.0f;
+
+private:
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnSpawnPointFreed(ETeam Team);
+
+	bool TrySpawn(const FNSSpawnRequest& Request);
+	void RecordWaitTime(float WaitTime);
+
+	// RequestTime  
+	TArray<FNSSpawnRequest> ReadyRequests;
+	// NextAttemptTime  
+	TArray<FNSSpawnRequest> BackoffRequests;
+	TSet<TWeakObjectPtr<AfpsNSCharacter>> Pending;
+
+	static const int32 MaxWaitSamples = 512;
+	TArray<float> WaitSamples;
+	int32 NextWaitSample = 0;
+
+	FNSRateCounter SpawnRate;
+
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle SpawnPointFreedHandle;
+};
@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSSpawnSelector.h"
+#include "fpsNS.h"
+#include "fpsNSCharacter.h"
+#include "NSSpawnPoint.h"
+#include "NSSpawnRegistry.h"
+#include "NSSpawnVisibilityData.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Candidates Scored"), STAT_fpsNS_SpawnCandidatesScored, STATGROUP_fpsNS);
+
+void UNSSpawnSelector::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency(UNSSpawnRegistry::StaticClass());
+	Super::Initialize(Collection);
+
+	Hash.SetCellSize(ThreatRadius);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UNSSpawnSelector::OnWorldPostActorTick);
+}
+
+void UNSSpawnSelector::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	Characters.Reset();
+	Hash.Reset();
+	VisibilityData = nullptr;
+	Super::Deinitialize();
+}
+
+void UNSSpawnSelector::RegisterCharacter(AfpsNSCharacter* Character)
+{
+	if (Character == nullptr || Characters.Contains(Character))
+	{
+		return;
+	}
+
+	//  ڸ ؼ ؽ Id  Ѵ
+	const int32 FreeSlot = Characters.Find(nullptr);
+	if (FreeSlot != INDEX_NONE)
+	{
+		Characters[FreeSlot] = Character;
+	}
+	else
+	{
+		Characters.Add(Character);
+	}
+}
+
+void UNSSpawnSelector::UnregisterCharacter(AfpsNSCharacter* Character)
+{
+	const int32 Id = Characters.Find(Character);
+	if (Id != INDEX_NONE)
+	{
+		Characters[Id] = nullptr;
+		Hash.Remove(Id);
+	}
+}
+
+void UNSSpawnSelector::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	//  ٲ ĳ͸ Ŷ ű
+	for (int32 Id = 0; Id < Characters.Num(); ++Id)
+	{
+		AfpsNSCharacter* Character = Characters[Id];
+		if (Character == nullptr || Character->bIsDead || Character->IsHidden())
+		{
+			Hash.Remove(Id);
+		}
+		else
+		{
+			Hash.Update(Id, Character->GetActorLocation(), int32(Character->CurrentTeam));
+		}
+	}
+}
+
+ANSSpawnPoint* UNSSpawnSelector::SelectSpawnPoint(ETeam Team)
+{
+	UNSSpawnRegistry* Registry = GetWorld()->GetSubsystem<UNSSpawnRegistry>();
+	if (Registry == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<ANSSpawnPoint*> Candidates;
+	Registry->GetFreeSpawnPoints(Team, Candidates);
+
+	const FNSSpawnScoreParams Params = GetScoreParams();
+	const UNSSpawnVisibilityData* Data = Candidates.Num() > 0 ? GetVisibilityData() : nullptr;
+	ANSSpawnPoint* BestSpawnPoint = nullptr;
+	float BestScore = -BIG_NUMBER;
+
+	for (ANSSpawnPoint* SpawnPoint : Candidates)
+	{
+		float Score = ScoreLocation(Hash, SpawnPoint->GetActorLocation(), int32(Team), Params) + FMath::FRand() * RandomWeight;
+		if (Data != nullptr)
+		{
+			Score -= VisibleEnemyWeight * CountVisibleEnemies(Data, SpawnPoint, int32(Team));
+		}
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestSpawnPoint = SpawnPoint;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_fpsNS_SpawnCandidatesScored, Candidates.Num());
+	return BestSpawnPoint;
+}
+
+AfpsNSCharacter* UNSSpawnSelector::FindNearestEnemy(const FVector& Location, ETeam Team, float Radius) const
+{
+	int32 BestId = INDEX_NONE;
+	float BestDistSq = BIG_NUMBER;
+
+	Hash.ForEachInRadius(Location, Radius, [&](int32 Id, const FVector& OtherLocation, int32 OtherTeam, float DistSq)
+	{
+		if (OtherTeam != int32(Team) && DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			BestId = Id;
+		}
+	});
+
+	return BestId != INDEX_NONE ? Characters[BestId] : nullptr;
+}
+
+float UNSSpawnSelector::ScoreLocation(const FNSSpatialHash& SpatialHash, const FVector& Location, int32 Team, const FNSSpawnScoreParams& Params)
+{
+	// ݰ ȿ      ݰ Ÿ ִ  
+	float NearestEnemyDistSq = FMath::Square(Params.ThreatRadius);
+	int32 NumEnemies = 0;
+	int32 NumTeammates = 0;
+
+	SpatialHash.ForEachInRadius(Location, Params.ThreatRadius, [&](int32 Id, const FVector& OtherLocation, int32 OtherTeam, float DistSq)
+	{
+		if (OtherTeam == Team)
+		{
+			++NumTeammates;
+		}
+		else
+		{
+			++NumEnemies;
+			NearestEnemyDistSq = FMath::Min(NearestEnemyDistSq, DistSq);
+		}
+	});
+
+	return Params.EnemyDistanceWeight * FMath::Sqrt(NearestEnemyDistSq) / Params.ThreatRadius
+		- Params.EnemyCountWeight * NumEnemies
+		+ Params.TeammateWeight * NumTeammates;
+}
+
+void UNSSpawnSelector::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//    Ѵ.   ù   ʵ     д´
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	// Ʈ  ƴ ۽ýƮ   ´
+	const FString MapPackageName = UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName());
+	const FString AssetPath = UNSSpawnVisibilityData::GetAssetPathForMap(MapPackageName);
+	if (FPackageName::DoesPackageExist(AssetPath))
+	{
+		VisibilityData = LoadObject<UNSSpawnVisibilityData>(nullptr, *(AssetPath + TEXT(".") + FPackageName::GetShortName(AssetPath)));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("No spawn visibility data for %s (%s), spawn scoring ignores line of sight"), *MapPackageName, *AssetPath);
+	}
+}
+
+int32 UNSSpawnSelector::CountVisibleEnemies(const UNSSpawnVisibilityData* Data, const ANSSpawnPoint* SpawnPoint, int32 Team) const
+{
+	const int32 SpawnIndex = Data->FindSpawnIndex(SpawnPoint->GetFName());
+	if (SpawnIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	int32 NumVisible = 0;
+	Hash.ForEachInRadius(SpawnPoint->GetActorLocation(), VisibilityRadius, [&](int32 Id, const FVector& OtherLocation, int32 OtherTeam, float DistSq)
+	{
+		if (OtherTeam != Team && Data->IsVisibleFrom(SpawnIndex, OtherLocation))
+		{
+			++NumVisible;
+		}
+	});
+	return NumVisible;
+}
+
+FNSSpawnScoreParams UNSSpawnSelector::GetScoreParams() const
+{
+	FNSSpawnScoreParams Params;
+	Params.ThreatRadius = ThreatRadius;
+	Params.EnemyDistanceWeight = EnemyDistanceWeight;
+	Params.EnemyCountWeight = EnemyCountWeight;
+	Params.TeammateWeight = TeammateWeight;
+	return Params;
+}
+
+#if !UE_BUILD_SHIPPING
+// ĺ  ÷̾ ȴ İ  ؽ ȸ Ѵ
+static void RunSpawnSelectBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumPlayers = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 128;
+	const int32 NumSpawnPoints = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 64;
+	const int32 Iterations = 1000;
+	const float MapExtent = 20000.0f;
+
+	FRandomStream Random(0x5EED);
+	FNSSpawnScoreParams Params;
+
+	TArray<FVector> Players;
+	TArray<int32> Teams;
+	FNSSpatialHash Hash(Params.ThreatRadius);
+	for (int32 Index = 0; Index < NumPlayers; ++Index)
+	{
+		Players.Add(FVector(Random.FRandRange(-MapExtent, MapExtent), Random.FRandRange(-MapExtent, MapExtent), 100.0f));
+		Teams.Add(Index % 2);
+		Hash.Update(Index, Players[Index], Teams[Index]);
+	}
+
+	TArray<FVector> SpawnPoints;
+	for (int32 Index = 0; Index < NumSpawnPoints; ++Index)
+	{
+		SpawnPoints.Add(FVector(Random.FRandRange(-MapExtent, MapExtent), Random.FRandRange(-MapExtent, MapExtent), 100.0f));
+	}
+
+	float Checksum = 0.0f;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FVector& SpawnPoint : SpawnPoints)
+		{
+			float NearestEnemyDistSq = FMath::Square(Params.ThreatRadius);
+			int32 NumEnemies = 0;
+			int32 NumTeammates = 0;
+			for (int32 Index = 0; Index < NumPlayers; ++Index)
+			{
+				const float DistSq = FVector::DistSquared(Players[Index], SpawnPoint);
+				if (DistSq > FMath::Square(Params.ThreatRadius))
+				{
+					continue;
+				}
+				if (Teams[Index] == 0)
+				{
+					++NumTeammates;
+				}
+				else
+				{
+					++NumEnemies;
+					NearestEnemyDistSq = FMath::Min(NearestEnemyDistSq, DistSq);
+				}
+			}
+			Checksum += Params.EnemyDistanceWeight * FMath::Sqrt(NearestEnemyDistSq) / Params.ThreatRadius
+				- Params.EnemyCountWeight * NumEnemies + Params.TeammateWeight * NumTeammates;
+		}
+	}
+	const double ScanTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FVector& SpawnPoint : SpawnPoints)
+		{
+			Checksum -= UNSSpawnSelector::ScoreLocation(Hash, SpawnPoint, 0, Params);
+		}
+	}
+	const double HashTime = FPlatformTime::Seconds() - StartTime;
+
+	//  ƽ   ÷̾ ݾ   ؽ  
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < NumPlayers; ++Index)
+		{
+			Players[Index] += FVector(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-10.0f, 10.0f), 0.0f);
+			Hash.Update(Index, Players[Index], Teams[Index]);
+		}
+	}
+	const double UpdateTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("Spawn selection, %d players x %d spawn points: scan %.2f us, spatial hash %.2f us per selection (checksum %.3f)"),
+		NumPlayers, NumSpawnPoints, ScanTime * 1e6 / Iterations, HashTime * 1e6 / Iterations, Checksum);
+	UE_LOG(LogTemp, Display, TEXT("Spatial hash update: %.2f us per tick for %d players"), UpdateTime * 1e6 / Iterations, NumPlayers);
+}
+
+static FAutoConsoleCommandWithArgs CmdSpawnSelectBench(
+	TEXT("fpsNS.SpawnSelectBench"),
+	TEXT("fpsNS.SpawnSelectBench [Players] [SpawnPoints]: compares brute-force and spatial-hash spawn scoring (default 128 x 64)."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunSpawnSelectBenchmark));
+#endif
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fpsNSGameMode.h"
+#include "NSSpatialHash.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSSpawnSelector.generated.h"
+
+class AfpsNSCharacter;
+class ANSSpawnPoint;
+class UNSSpawnVisibilityData;
+
+/**    꿡   */
+struct FNSSpawnScoreParams
+{
+	float ThreatRadius = 3000.0f;
+	float EnemyDistanceWeight = 1.0f;
+	float EnemyCountWeight = 0.25f;
+	float TeammateWeight = 0.1f;
+};
+
+/**
+ *  ִ ĳ͸  ؽÿ ϰ,     Լ   .
+ * ĺ ֺ  ȸϹǷ ÷̾     ʴ´.
+ */
+UCLASS(config=Game)
+class FPSNS_API UNSSpawnSelector : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void RegisterCharacter(AfpsNSCharacter* Character);
+	void UnregisterCharacter(AfpsNSCharacter* Character);
+
+	//         .  nullptr
+	ANSSpawnPoint* SelectSpawnPoint(ETeam Team);
+
+	// ݰ ȿ    ִ .  nullptr
+	AfpsNSCharacter* FindNearestEnemy(const FVector& Location, ETeam Team, float Radius) const;
+
+	//   
+	static float ScoreLocation(const FNSSpatialHash& SpatialHash, const FVector& Location, int32 Team, const FNSSpawnScoreParams& Params);
+
+	/**   ݰ (cm).  ؽ  ũε  */
+	UPROPERTY(Config)
+	float ThreatRadius = 3000.0f;
+
+	/**    Ÿ (ThreatRadius ȭ) ġ */
+	UPROPERTY(Config)
+	float EnemyDistanceWeight = 1.0f;
+
+	/** ݰ      */
+	UPROPERTY(Config)
+	float EnemyCountWeight = 0.25f;
+
+	/** ݰ  Ʊ    */
+	UPROPERTY(Config)
+	float TeammateWeight = 0.1f;
+
+	/**     ʵ ϴ   ũ */
+	UPROPERTY(Config)
+	float RandomWeight = 0.05f;
+
+	/**   ü ǥ     ִ     */
+	UPROPERTY(Config)
+	float VisibleEnemyWeight = 0.5f;
+
+	/** ü Ȯ  ִ Ÿ (cm) */
+	UPROPERTY(Config)
+	float VisibilityRadius = 10000.0f;
+
+private:
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	//  ü ǥ ó ʿ  ҷ´.  nullptr
+	UNSSpawnVisibilityData* GetVisibilityData() const { return VisibilityData; }
+
+	int32 CountVisibleEnemies(const UNSSpawnVisibilityData* Data, const ANSSpawnPoint* SpawnPoint, int32 Team) const;
+
+	FNSSpawnScoreParams GetScoreParams() const;
+
+	// ε  ؽ Id.  ڸ nullptr
+	UPROPERTY()
+	TArray<AfpsNSCharacter*> Characters;
+
+	FNSSpatialHash Hash;
+
+	UPROPERTY()
+	UNSSpawnVisibilityData* VisibilityData = nullptr;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSSpawnVisibilityData.h"
+#include "Misc/Compression.h"
+
+FString UNSSpawnVisibilityData::GetAssetPathForMap(const FString& MapPackageName)
+{
+	//   DirectoriesToAlwaysCook   ° Ѵ
+	return FString(TEXT("/Game/NS/SpawnVisibility/")) + FPackageName::GetShortName(MapPackageName) + TEXT("_SpawnVisibility");
+}
+
+int32 UNSSpawnVisibilityData::FindSpawnIndex(FName SpawnPointName) const
+{
+	Decompress();
+
+	const int32* Index = SpawnIndices.Find(SpawnPointName);
+	return Index ? *Index : INDEX_NONE;
+}
+
+bool UNSSpawnVisibilityData::IsVisibleFrom(int32 SpawnIndex, const FVector& Location) const
+{
+	Decompress();
+
+	const int32 CellX = FMath::FloorToInt((Location.X - GridOrigin.X) / CellSize);
+	const int32 CellY = FMath::FloorToInt((Location.Y - GridOrigin.Y) / CellSize);
+	if (!SpawnPointNames.IsValidIndex(SpawnIndex) || CellX < 0 || CellY < 0 || CellX >= GridSize.X || CellY >= GridSize.Y)
+	{
+		return false;
+	}
+
+	const int32 BitIndex = SpawnIndex * GetNumCells() + CellY * GridSize.X + CellX;
+	const int32 ByteIndex = BitIndex >> 3;
+	return Bits.IsValidIndex(ByteIndex) && (Bits[ByteIndex] & (1 << (BitIndex & 7))) != 0;
+}
+
+void UNSSpawnVisibilityData::SetVisibilityBits(const TBitArray<>& VisibilityBits)
+{
+	Bits.SetNumZeroed((VisibilityBits.Num() + 7) / 8);
+	for (TConstSetBitIterator<> It(VisibilityBits); It; ++It)
+	{
+		Bits[It.GetIndex() >> 3] |= 1 << (It.GetIndex() & 7);
+	}
+	UncompressedSize = Bits.Num();
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+	CompressedBits.SetNumUninitialized(CompressedSize);
+	if (FCompression::CompressMemory(NAME_Zlib, CompressedBits.GetData(), CompressedSize, Bits.GetData(), UncompressedSize))
+	{
+		CompressedBits.SetNum(CompressedSize);
+	}
+	else
+	{
+		CompressedBits.Reset();
+		UncompressedSize = 0;
+	}
+
+	SpawnIndices.Reset();
+	bDecompressed = false;
+}
+
+void UNSSpawnVisibilityData::Decompress() const
+{
+	if (bDecompressed)
+	{
+		return;
+	}
+	bDecompressed = true;
+
+	for (int32 Index = 0; Index < SpawnPointNames.Num(); ++Index)
+	{
+		SpawnIndices.Add(SpawnPointNames[Index], Index);
+	}
+
+	if (Bits.Num() == UncompressedSize && UncompressedSize > 0)
+	{
+		return;
+	}
+
+	Bits.SetNumUninitialized(UncompressedSize);
+	if (UncompressedSize == 0 || !FCompression::UncompressMemory(NAME_Zlib, Bits.GetData(), UncompressedSize, CompressedBits.GetData(), CompressedBits.Num()))
+	{
+		Bits.Reset();
+	}
+}
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "NSSpawnVisibilityData.generated.h"
+
+/**
+ *  XY      ̴   ǥ.
+ * NSBakeSpawnVisibility Ŀǵ巿 , Ʈ zlib  Ѵ.
+ *   ó ȸ    Ѵ.
+ */
+UCLASS()
+class FPSNS_API UNSSpawnVisibilityData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//  Ű ̸κ ǥ  θ  (: /Game/NS/SpawnVisibility/Map_SpawnVisibility)
+	static FString GetAssetPathForMap(const FString& MapPackageName);
+
+	int32 FindSpawnIndex(FName SpawnPointName) const;
+
+	// Location     ̴.  ̸ false
+	bool IsVisibleFrom(int32 SpawnIndex, const FVector& Location) const;
+
+	int32 GetNumCells() const { return GridSize.X * GridSize.Y; }
+
+	//   ؼ Ѵ.   NumCells Ʈ ̾
+	void SetVisibilityBits(const TBitArray<>& VisibilityBits);
+
+	UPROPERTY(VisibleAnywhere, Category = Visibility)
+	FVector GridOrigin;
+
+	UPROPERTY(VisibleAnywhere, Category = Visibility)
+	float CellSize = 400.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = Visibility)
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+
+	UPROPERTY(VisibleAnywhere, Category = Visibility)
+	TArray<FName> SpawnPointNames;
+
+private:
+	void Decompress() const;
+
+	UPROPERTY()
+	TArray<uint8> CompressedBits;
+
+	UPROPERTY()
+	int32 UncompressedSize = 0;
+
+	mutable TArray<uint8> Bits;
+	mutable TMap<FName, int32> SpawnIndices;
+	mutable bool bDecompressed = false;
+};
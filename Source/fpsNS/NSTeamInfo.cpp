@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSTeamInfo.h"
+#include "NSPlayerState.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+ANSTeamInfo::ANSTeamInfo(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	bReplicates = true;
+	bAlwaysRelevant = false;
+	NetUpdateFrequency = 10.0f;
+	Team = ETeam::BLUE_TEAM;
+}
+
+bool ANSTeamInfo::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	const APlayerController* Controller = Cast<APlayerController>(RealViewer);
+	const ANSPlayerState* ViewerState = Controller ? Controller->GetPlayerState<ANSPlayerState>() : nullptr;
+	return ViewerState != nullptr && ViewerState->GetTeam() == Team;
+}
+
+void ANSTeamInfo::SetMemberHealth(ANSPlayerState* PlayerState, uint8 CoarseHealth)
+{
+	FNSTeamMemberHealth* Member = Members.FindByPredicate([PlayerState](const FNSTeamMemberHealth& Entry) { return Entry.PlayerState == PlayerState; });
+	if (Member == nullptr)
+	{
+		Member = &Members.AddDefaulted_GetRef();
+		Member->PlayerState = PlayerState;
+	}
+	else if (Member->CoarseHealth == CoarseHealth)
+	{
+		return;
+	}
+
+	Member->CoarseHealth = CoarseHealth;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ANSTeamInfo, Members, this);
+}
+
+void ANSTeamInfo::RemoveMember(ANSPlayerState* PlayerState)
+{
+	if (Members.RemoveAllSwap([PlayerState](const FNSTeamMemberHealth& Entry) { return Entry.PlayerState == PlayerState; }) > 0)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(ANSTeamInfo, Members, this);
+	}
+}
+
+void ANSTeamInfo::OnRep_Members()
+{
+	//    ÷̾ Ʈ   ٽ ȣȴ
+	for (const FNSTeamMemberHealth& Member : Members)
+	{
+		if (Member.PlayerState != nullptr)
+		{
+			Member.PlayerState->ApplyTeamHealth(Member.CoarseHealth);
+		}
+	}
+}
+
+void ANSTeamInfo::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(ANSTeamInfo, Team, COND_InitialOnly);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ANSTeamInfo, Members, Params);
+}
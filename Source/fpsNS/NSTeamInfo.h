@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NSTeamRegistry.h"
+#include "GameFramework/Info.h"
+#include "NSTeamInfo.generated.h"
+
+class ANSPlayerState;
+
+USTRUCT()
+struct FNSTeamMemberHealth
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ANSPlayerState* PlayerState = nullptr;
+
+	// 10ܰ ü.   0  ʴ´
+	UPROPERTY()
+	uint8 CoarseHealth = 10;
+};
+
+/**
+ *  ü   ῡ .
+ *  ׷  尡   ῡ , ׷   IsNetRelevantFor Ÿ.
+ */
+UCLASS(NotPlaceable)
+class FPSNS_API ANSTeamInfo : public AInfo
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+
+	// :  ߰ϰ,  ٲ  Ƽ ǥѴ
+	void SetMemberHealth(ANSPlayerState* PlayerState, uint8 CoarseHealth);
+	void RemoveMember(ANSPlayerState* PlayerState);
+
+	UPROPERTY(Replicated)
+	ETeam Team;
+
+private:
+	UFUNCTION()
+	void OnRep_Members();
+
+	UPROPERTY(ReplicatedUsing = OnRep_Members)
+	TArray<FNSTeamMemberHealth> Members;
+};
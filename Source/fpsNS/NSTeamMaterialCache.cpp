@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSTeamMaterialCache.h"
+#include "NSTeamRegistry.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+void UNSTeamMaterialCache::Deinitialize()
+{
+	TeamMaterials.Reset();
+	Super::Deinitialize();
+}
+
+UMaterialInstanceDynamic* UNSTeamMaterialCache::GetTeamMaterial(ETeam Team, UMaterialInterface* BaseMaterial)
+{
+	if (Team >= ETeam::MAX)
+	{
+		return nullptr;
+	}
+
+	if (TeamMaterials.Num() == 0)
+	{
+		TeamMaterials.SetNumZeroed(int32(ETeam::MAX));
+	}
+
+	UMaterialInstanceDynamic*& Material = TeamMaterials[int32(Team)];
+	if (Material == nullptr && BaseMaterial != nullptr)
+	{
+		// ̹ ٸ    ̸  θ Ƽ 
+		if (UMaterialInstanceDynamic* Dynamic = Cast<UMaterialInstanceDynamic>(BaseMaterial))
+		{
+			BaseMaterial = Dynamic->Parent;
+		}
+
+		Material = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+		Material->SetVectorParameterValue(TEXT("BodyColor"), GetTeamColor(Team));
+	}
+	return Material;
+}
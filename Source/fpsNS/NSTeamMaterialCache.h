@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fpsNSGameMode.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NSTeamMaterialCache.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ *   Ƽ  ϳ    ü 1Ī ޽ð  .
+ * Ƽ νϽ  ÷̾  ƴ϶   Ѵ.
+ */
+UCLASS()
+class FPSNS_API UNSTeamMaterialCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	//  Ƽ ش. ó û  BaseMaterial 
+	UMaterialInstanceDynamic* GetTeamMaterial(ETeam Team, UMaterialInterface* BaseMaterial);
+
+private:
+	// ETeam .     nullptr
+	UPROPERTY()
+	TArray<UMaterialInstanceDynamic*> TeamMaterials;
+};
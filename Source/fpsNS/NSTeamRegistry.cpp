@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NSTeamRegistry.h"
+#include "GameFramework/PlayerState.h"
+
+void FNSTeamRegistry::Reset(int32 InNumTeams)
+{
+	Slots.Reset();
+	FreeSlots.Reset();
+	Members.Reset();
+	Members.SetNum(FMath::Clamp(InNumTeams, 1, int32(ETeam::MAX)));
+}
+
+FNSTeamHandle FNSTeamRegistry::Join(APlayerState* PlayerState, ETeam Team)
+{
+	check(Members.IsValidIndex(int32(Team)));
+
+	const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(false) : Slots.AddDefaulted();
+	FSlot& Slot = Slots[SlotIndex];
+	TArray<int32>& TeamMembers = Members[int32(Team)];
+
+	Slot.PlayerState = PlayerState;
+	Slot.Team = Team;
+	Slot.MemberIndex = TeamMembers.Add(SlotIndex);
+	Slot.bUsed = true;
+
+	FNSTeamHandle Handle;
+	Handle.Index = SlotIndex;
+	Handle.Generation = Slot.Generation;
+	return Handle;
+}
+
+FNSTeamHandle FNSTeamRegistry::JoinSmallestTeam(APlayerState* PlayerState)
+{
+	return Join(PlayerState, GetSmallestTeam());
+}
+
+bool FNSTeamRegistry::Leave(FNSTeamHandle Handle)
+{
+	if (!IsValid(Handle))
+	{
+		return false;
+	}
+
+	FSlot& Slot = Slots[Handle.Index];
+	TArray<int32>& TeamMembers = Members[int32(Slot.Team)];
+
+	//   ڸ ű
+	const int32 LastSlotIndex = TeamMembers.Last();
+	TeamMembers[Slot.MemberIndex] = LastSlotIndex;
+	Slots[LastSlotIndex].MemberIndex = Slot.MemberIndex;
+	TeamMembers.Pop(false);
+
+	Slot.PlayerState.Reset();
+	Slot.MemberIndex = INDEX_NONE;
+	Slot.bUsed = false;
+	++Slot.Generation;
+	FreeSlots.Add(Handle.Index);
+	return true;
+}
+
+bool FNSTeamRegistry::IsValid(FNSTeamHandle Handle) const
+{
+	return Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].bUsed && Slots[Handle.Index].Generation == Handle.Generation;
+}
+
+bool FNSTeamRegistry::IsValid(FNSTeamHandle Handle, const APlayerState* PlayerState) const
+{
+	return IsValid(Handle) && Slots[Handle.Index].PlayerState.Get() == PlayerState;
+}
+
+ETeam FNSTeamRegistry::GetTeam(FNSTeamHandle Handle) const
+{
+	return IsValid(Handle) ? Slots[Handle.Index].Team : ETeam::BLUE_TEAM;
+}
+
+int32 FNSTeamRegistry::GetTeamSize(ETeam Team) const
+{
+	return Members.IsValidIndex(int32(Team)) ? Members[int32(Team)].Num() : 0;
+}
+
+ETeam FNSTeamRegistry::GetSmallestTeam() const
+{
+	int32 Smallest = 0;
+	for (int32 Team = 1; Team < Members.Num(); ++Team)
+	{
+		if (Members[Team].Num() < Members[Smallest].Num())
+		{
+			Smallest = Team;
+		}
+	}
+	return ETeam(Smallest);
+}
+
+FLinearColor GetTeamColor(ETeam Team)
+{
+	switch (Team)
+	{
+	case ETeam::RED_TEAM:
+		return FLinearColor(0.5f, 0.0f, 0.0f);
+	case ETeam::GREEN_TEAM:
+		return FLinearColor(0.0f, 0.5f, 0.0f);
+	case ETeam::YELLOW_TEAM:
+		return FLinearColor(0.5f, 0.5f, 0.0f);
+	default:
+		return FLinearColor(0.0f, 0.0f, 0.5f);
+	}
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NSTeamRegistry.generated.h"
+
+class APlayerState;
+
+UENUM(BlueprintType)
+enum class ETeam : uint8
+{
+	BLUE_TEAM,
+	RED_TEAM,
+	GREEN_TEAM,
+	YELLOW_TEAM,
+	MAX UMETA(Hidden)
+};
+
+/**  Ʈ  Ų.  Ǹ 밡 ޶ ȿ ȴ */
+struct FNSTeamHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+/**
+ * ÷̾ Ʈ  Ҽ Ѵ.
+ *     迭 ξ , Ż, ο 񱳰  O(1)̴.
+ */
+class FPSNS_API FNSTeamRegistry
+{
+public:
+	void Reset(int32 InNumTeams);
+
+	int32 GetNumTeams() const { return Members.Num(); }
+
+	FNSTeamHandle Join(APlayerState* PlayerState, ETeam Team);
+
+	// ο    ִ´
+	FNSTeamHandle JoinSmallestTeam(APlayerState* PlayerState);
+
+	bool Leave(FNSTeamHandle Handle);
+
+	// ڵ   ÷̾ Ʈ Ű
+	bool IsValid(FNSTeamHandle Handle, const APlayerState* PlayerState) const;
+
+	ETeam GetTeam(FNSTeamHandle Handle) const;
+
+	int32 GetTeamSize(ETeam Team) const;
+
+	// ο   ȣ 
+	ETeam GetSmallestTeam() const;
+
+private:
+	struct FSlot
+	{
+		TWeakObjectPtr<APlayerState> PlayerState;
+		uint32 Generation = 0;
+		int32 MemberIndex = INDEX_NONE;
+		ETeam Team = ETeam::BLUE_TEAM;
+		bool bUsed = false;
+	};
+
+	bool IsValid(FNSTeamHandle Handle) const;
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	//   ε
+	TArray<TArray<int32>> Members;
+};
+
+//   (ĳ    ǥÿ )
+FPSNS_API FLinearColor GetTeamColor(ETeam Team);
@@ -3,5 +3,7 @@
 #include "fpsNS.h"
 #include "Modules/ModuleManager.h"
 
+CSV_DEFINE_CATEGORY_MODULE(FPSNS_API, fpsNS, true);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, fpsNS, "fpsNS" );
  
\ No newline at end of file
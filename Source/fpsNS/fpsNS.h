@@ -3,3 +3,33 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("fpsNS"), STATGROUP_fpsNS, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FPSNS_API, fpsNS);
+
+/** 1  ʴ Ƚ Ѵ */
+struct FNSRateCounter
+{
+	void Add(int32 Count = 1) { Pending += Count; }
+
+	void Tick(float DeltaSeconds)
+	{
+		Elapsed += DeltaSeconds;
+		if (Elapsed >= 1.0f)
+		{
+			Rate = Pending / Elapsed;
+			Pending = 0;
+			Elapsed = 0.0f;
+		}
+	}
+
+	float GetRate() const { return Rate; }
+
+private:
+	int32 Pending = 0;
+	float Elapsed = 0.0f;
+	float Rate = 0.0f;
+};
@@ -1,22 +1,38 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "fpsNSCharacter.h"
+#include "fpsNS.h"
 #include "fpsNSProjectile.h"
+#include "NSHitscanResolver.h"
+#include "NSEffectPool.h"
+#include "NSRagdollManager.h"
+#include "NSSpawnSelector.h"
+#include "NSTeamMaterialCache.h"
+#include "NSReplicationGraph.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "GameFramework/GameStateBase.h"
 #include "GameFramework/InputSettings.h"
 #include "Net/UnrealNetwork.h"
-#include "DrawDebugHelpers.h"
-#include "HeadMountedDisplayFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
-#include "MotionControllerComponent.h"
-#include "XRMotionControllerBase.h" // for FXRMotionControllerBase::RightHandSourceId
+#include "HAL/IConsoleManager.h"
+#include "EngineUtils.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogFPChar, Warning, All);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shots Rejected"), STAT_fpsNS_ShotsRejected, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ServerFire Calls"), STAT_fpsNS_ServerFireCalls, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TakeDamage Calls"), STAT_fpsNS_TakeDamageCalls, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("Character Fire"), STAT_fpsNS_CharacterFire, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("ServerFire"), STAT_fpsNS_ServerFire, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("TakeDamage"), STAT_fpsNS_TakeDamage, STATGROUP_fpsNS);
+
 //////////////////////////////////////////////////////////////////////////
 // AfpsNSCharacter
 
@@ -29,12 +45,36 @@ AfpsNSCharacter::AfpsNSCharacter()
 	BaseTurnRate = 45.f;
 	BaseLookUpRate = 45.f;
 
+	WeaponRange = 100000.0f;
+	NextFireSequence = 0;
+	LastFireSequence = 0;
+	bHasFireSequence = false;
+	RejectedShots = 0;
+	NextShotEventSequence = 0;
+	bIsDead = false;
+
+	FireRate = 10.0f;
+	FireBurst = 3.0f;
+	MaxFireOriginError = 200.0f;
+
+	IdleNetUpdateFrequency = 5.0f;
+	MovingNetUpdateFrequency = 20.0f;
+	FiringNetUpdateFrequency = 30.0f;
+	FiringNetBoostTime = 0.5f;
+	NetActivity = ENSNetActivity::Idle;
+	LastFireTime = -MAX_flt;
+	NetUpdateFrequency = 20.0f;
+	MinNetUpdateFrequency = 2.0f;
+
 	// Create a CameraComponent	
 	FirstPersonCameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("FirstPersonCamera"));
 	FirstPersonCameraComponent->SetupAttachment(GetCapsuleComponent());
 	FirstPersonCameraComponent->SetRelativeLocation(FVector(-39.56f, 1.75f, 64.f)); // Position the camera
 	FirstPersonCameraComponent->bUsePawnControlRotation = true;
 
+	GetMesh()->SetOwnerNoSee(true);
+
+	// Ʈ  Ʈ  ϹǷ  忡 . Ƽ  StripCosmetics 
 	// Create a mesh component that will be used when being viewed from a '1st person' view (when controlling this pawn)
 	FP_Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("FP_Mesh"));
 	FP_Mesh->SetOnlyOwnerSee(true);
@@ -60,8 +100,6 @@ AfpsNSCharacter::AfpsNSCharacter()
 	TP_Gun->SetOwnerNoSee(true);
 	TP_Gun->SetupAttachment(GetMesh(), TEXT("hand_rSocket"));
 
-	GetMesh()->SetOwnerNoSee(true);
-
 	//ƼŬ 
 	TP_GunShotParticle = CreateDefaultSubobject<UParticleSystemComponent>(TEXT("ParticleSysTP"));
 	TP_GunShotParticle->bAutoActivate = false;
@@ -93,6 +131,9 @@ void AfpsNSCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInp
 	// Bind fire event
 	PlayerInputComponent->BindAction("Fire", IE_Pressed, this, &AfpsNSCharacter::OnFire);
 
+	// Bind match start event
+	PlayerInputComponent->BindAction("StartMatch", IE_Pressed, this, &AfpsNSCharacter::OnStartMatch);
+
 	// Bind movement events
 	PlayerInputComponent->BindAxis("MoveForward", this, &AfpsNSCharacter::MoveForward);
 	PlayerInputComponent->BindAxis("MoveRight", this, &AfpsNSCharacter::MoveRight);
@@ -110,28 +151,39 @@ void AfpsNSCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME(AfpsNSCharacter, CurrentTeam);
+	DOREPLIFETIME(AfpsNSCharacter, ShotEvents);
+	DOREPLIFETIME(AfpsNSCharacter, bIsDead);
 }
 
 float AfpsNSCharacter::TakeDamage(float Damage, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_TakeDamage);
+	CSV_SCOPED_TIMING_STAT(fpsNS, TakeDamage);
+	INC_DWORD_STAT(STAT_fpsNS_TakeDamageCalls);
+
 	Super::TakeDamage(Damage, DamageEvent, EventInstigator, DamageCauser);
 
-	if (GetLocalRole() == ROLE_Authority && DamageCauser != this && NSPlayerState->Health > 0)
+	if (GetLocalRole() == ROLE_Authority && DamageCauser != this && NSPlayerState->GetHealth() > 0)
 	{
-		NSPlayerState->Health -= Damage;
+		NSPlayerState->SetHealth(NSPlayerState->GetHealth() - Damage);
 		PlayPain();
 
-		if (NSPlayerState->Health <= 0)
+		if (NSPlayerState->GetHealth() <= 0)
 		{
-			NSPlayerState->Deaths++;
+			NSPlayerState->AddDeath();
 
 			// ÷̾  ð  ״´
-			MultiCastRagdoll();
+			bIsDead = true;
+			OnRep_IsDead();
+
+			//  ٲ  Ƿ  ¸   ޸Ѵ
+			GetCharacterMovement()->DisableMovement();
+			SetNetActivity(ENSNetActivity::Dormant);
 			AfpsNSCharacter* OtherChar = Cast<AfpsNSCharacter>(DamageCauser);
 
 			if (OtherChar)
 			{
-				OtherChar->NSPlayerState->Score += 1.0f;
+				OtherChar->NSPlayerState->SetScore(OtherChar->NSPlayerState->GetScore() + 1.0f);
 			}
 
 			// 3  ȴ
@@ -143,6 +195,41 @@ float AfpsNSCharacter::TakeDamage(float Damage, FDamageEvent const& DamageEvent,
 	return Damage;
 }
 
+void AfpsNSCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// ڿ ϸ Ʈ CDO Ű  νϽ ȴ
+	ShotEvents.Owner = this;
+
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		StripCosmetics();
+	}
+}
+
+void AfpsNSCharacter::StripCosmetics()
+{
+	//  ĸθ ϹǷ    ʿ䰡 
+	GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+
+	USceneComponent* Cosmetics[] = { FP_GunShotParticle, TP_GunShotParticle, BulletParticle, FP_Gun, TP_Gun, FP_Mesh };
+	for (USceneComponent* Component : Cosmetics)
+	{
+		if (Component != nullptr)
+		{
+			Component->DestroyComponent();
+		}
+	}
+
+	FP_GunShotParticle = nullptr;
+	TP_GunShotParticle = nullptr;
+	BulletParticle = nullptr;
+	FP_Gun = nullptr;
+	TP_Gun = nullptr;
+	FP_Mesh = nullptr;
+}
+
 void AfpsNSCharacter::BeginPlay()
 {
 	// Call the base class  
@@ -150,8 +237,51 @@ void AfpsNSCharacter::BeginPlay()
 
 	if (GetLocalRole() != ROLE_Authority)
 	{
-		SetTeam(CurrentTeam);
+		// ʱⰪ  ̸ OnRep Ҹ Ƿ    
+		UpdateTeamMaterial();
+	}
+	else
+	{
+		if (UNSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UNSLagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
+
+		if (UNSSpawnSelector* SpawnSelector = GetWorld()->GetSubsystem<UNSSpawnSelector>())
+		{
+			SpawnSelector->RegisterCharacter(this);
+		}
+
+		// Ȱ ´    ʿ䰡 
+		GetWorldTimerManager().SetTimer(NetActivityTimer, this, &AfpsNSCharacter::UpdateNetActivity, 0.25f, true);
+	}
+
+	// Ѿ Ʈ ̸  ξ ù     ʵ Ѵ
+	UNSEffectPool* EffectPool = GetWorld()->GetSubsystem<UNSEffectPool>();
+	if (EffectPool != nullptr && BulletParticle != nullptr)
+	{
+		EffectPool->Prewarm(BulletParticle->Template);
+	}
+}
+
+void AfpsNSCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UNSLagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	if (UNSRagdollManager* RagdollManager = GetWorld()->GetSubsystem<UNSRagdollManager>())
+	{
+		RagdollManager->ReleaseRagdoll(this);
+	}
+
+	if (UNSSpawnSelector* SpawnSelector = GetWorld()->GetSubsystem<UNSSpawnSelector>())
+	{
+		SpawnSelector->UnregisterCharacter(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AfpsNSCharacter::PossessedBy(AController* NewController)
@@ -162,7 +292,7 @@ void AfpsNSCharacter::PossessedBy(AController* NewController)
 
 	if (GetLocalRole() == ROLE_Authority && NSPlayerState != nullptr)
 	{
-		NSPlayerState->Health = 100.0f;
+		NSPlayerState->SetHealth(ANSPlayerState::MaxHealth);
 	}
 }
 
@@ -175,7 +305,7 @@ void AfpsNSCharacter::OnFire()
 	//}
 
 	// try and play a firing animation if specified
-	if (FP_FireAnimation != nullptr)
+	if (FP_FireAnimation != nullptr && FP_Mesh != nullptr)
 	{
 		// Get the animation object for the arms mesh
 		UAnimInstance* AnimInstance = FP_Mesh->GetAnimInstance();
@@ -198,9 +328,41 @@ void AfpsNSCharacter::OnFire()
 	FVector2D ScreenPos = GEngine->GameViewport->Viewport->GetSizeXY();
 
 	pController->DeprojectScreenPositionToWorld(ScreenPos.X / 2.0f, ScreenPos.Y / 2.0f, mousePos, mouseDir);
-	mouseDir *= 10000000.0f;
 
-	ServerFire(mousePos, mouseDir);
+	SendFireCommand(mousePos, mouseDir);
+}
+
+void AfpsNSCharacter::SendFireCommand(const FVector& Origin, const FVector& Direction)
+{
+	FNSFireCommand Command;
+	Command.Origin = Origin;
+	Command.SetDirection(Direction);
+	Command.Sequence = NextFireSequence++;
+
+	// GetServerWorldTimeSeconds   ð պ      ð  ̶
+	//  ŭ ʴ. ٸ ĳ ġ  ŭ ʰ ϹǷ   ǰ,
+	//   ùķƼ Ͻ  ̴. ׸ŭ  ȭ鿡 ׷   
+	AGameStateBase* GameState = GetWorld()->GetGameState();
+	float ViewTime = GameState != nullptr ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
+	const UCharacterMovementComponent* Movement = GetCharacterMovement();
+	if (GetNetMode() == NM_Client && Movement->NetworkSmoothingMode != ENetworkSmoothingMode::Disabled)
+	{
+		ViewTime -= Movement->NetworkSimulatedSmoothLocationTime;
+	}
+	Command.SetTimestamp(ViewTime);
+
+	ServerFire(Command);
+}
+
+void AfpsNSCharacter::OnStartMatch()
+{
+	//   ȣƮ   ִ. Ƽ  ܼ StartMatch ڵ  
+	AfpsNSGameMode* GameMode = GetWorld()->GetAuthGameMode<AfpsNSGameMode>();
+	if (GameMode != nullptr && IsLocallyControlled())
+	{
+		GameMode->StartMatch();
+	}
 }
 
 void AfpsNSCharacter::MoveForward(float Value)
@@ -233,36 +395,38 @@ void AfpsNSCharacter::LookUpAtRate(float Rate)
 	AddControllerPitchInput(Rate * BaseLookUpRate * GetWorld()->GetDeltaSeconds());
 }
 
-void AfpsNSCharacter::Fire(const FVector pos, const FVector dir)
+void AfpsNSCharacter::Fire(const FVector pos, const FVector end, float ViewTime)
 {
-	//ĳƮ 
-	FCollisionObjectQueryParams ObjQuery;
-	ObjQuery.AddObjectTypesToQuery(ECC_GameTraceChannel1);
-
-	FCollisionQueryParams ColQuery;
-	ColQuery.AddIgnoredActor(this);
-
-	FHitResult HitRes;
-	GetWorld()->LineTraceSingleByObjectType(HitRes, pos, dir, ObjQuery, ColQuery);
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_CharacterFire);
+	CSV_SCOPED_TIMING_STAT(fpsNS, CharacterFire);
 
-	DrawDebugLine(GetWorld(), pos, dir, FColor::Red, true, 100, 0, 5.0f);
+	//    ƽ Ƽ óѴ
+	UNSHitscanResolver* Resolver = GetWorld()->GetSubsystem<UNSHitscanResolver>();
+	if (Resolver != nullptr)
+	{
+		Resolver->QueueShot(this, pos, end, ViewTime);
+	}
+}
 
-	if (HitRes.bBlockingHit)
+void AfpsNSCharacter::OnShotResolved(const FHitResult& HitRes)
+{
+	AfpsNSCharacter* OtherChar = Cast<AfpsNSCharacter>(HitRes.GetActor());
+	if (OtherChar != nullptr && OtherChar->GetNSPlayerState()->GetTeam() != this->GetNSPlayerState()->GetTeam())
 	{
-		AfpsNSCharacter* OtherChar = Cast<AfpsNSCharacter>(HitRes.GetActor());
-		if (OtherChar != nullptr && OtherChar->GetNSPlayerState()->Team != this->GetNSPlayerState()->Team)
+		FDamageEvent thisEvent(UDamageType::StaticClass());
+		OtherChar->TakeDamage(10.0f, thisEvent, this->GetController(), this);
+		APlayerController* thisPC = Cast<APlayerController>(GetController());
+		if (thisPC != nullptr)
 		{
-			FDamageEvent thisEvent(UDamageType::StaticClass());
-			OtherChar->TakeDamage(10.0f, thisEvent, this->GetController(), this);
-			APlayerController* thisPC = Cast<APlayerController>(GetController());
 			thisPC->ClientPlayForceFeedback(HitSuccessFeedback, false, NAME_None);
 		}
 	}
 }
 
-bool AfpsNSCharacter::ServerFire_Validate(const FVector pos, const FVector dir)
+bool AfpsNSCharacter::ServerFire_Validate(const FNSFireCommand& Command)
 {
-	if (pos != FVector(ForceInit) && dir != FVector(ForceInit))
+	// ⼭ false ȯϸ  Ƿ ߸ Ŷ Ÿ
+	if (Command.Origin != FVector(ForceInit) && !Command.Origin.ContainsNaN())
 	{
 		return true;
 	}
@@ -272,13 +436,150 @@ bool AfpsNSCharacter::ServerFire_Validate(const FVector pos, const FVector dir)
 	}
 }
 
-void AfpsNSCharacter::ServerFire_Implementation(const FVector pos, const FVector dir)
+bool AfpsNSCharacter::AcceptFireCommand(const FNSFireCommand& Command)
 {
-	Fire(pos, dir);
-	MultiCastShootEffects();
+	//  8Ʈ ưǷ ȣ ִ ̷ Ѵ
+	if (bHasFireSequence && int8(uint8(Command.Sequence - LastFireSequence)) <= 0)
+	{
+		UE_LOG(LogFPChar, Verbose, TEXT("%s: rejected shot, sequence %d after %d"), *GetName(), Command.Sequence, LastFireSequence);
+		return false;
+	}
+
+	//   ø.  ˻翡 źεŵ Ŭ̾Ʈ   ̹ 
+	LastFireSequence = Command.Sequence;
+	bHasFireSequence = true;
+
+	if (bIsDead)
+	{
+		UE_LOG(LogFPChar, Verbose, TEXT("%s: rejected shot, dead"), *GetName());
+		return false;
+	}
+
+	if (FVector::DistSquared(Command.Origin, FirstPersonCameraComponent->GetComponentLocation()) > FMath::Square(MaxFireOriginError))
+	{
+		UE_LOG(LogFPChar, Verbose, TEXT("%s: rejected shot, origin too far from camera"), *GetName());
+		return false;
+	}
+
+	if (!FireRateLimiter.TryConsume(GetWorld()->GetTimeSeconds(), FireRate, FireBurst))
+	{
+		UE_LOG(LogFPChar, Verbose, TEXT("%s: rejected shot, fire rate exceeded"), *GetName());
+		return false;
+	}
+
+	return true;
 }
 
-void AfpsNSCharacter::MultiCastShootEffects_Implementation()
+void AfpsNSCharacter::UpdateNetActivity()
+{
+	// ޸  Ǯ Ѵ
+	if (NetActivity == ENSNetActivity::Dormant)
+	{
+		return;
+	}
+
+	const FRotator AimRotation = GetBaseAimRotation();
+	const bool bAimChanged = !AimRotation.Equals(LastNetActivityRotation, 1.0f);
+	LastNetActivityRotation = AimRotation;
+
+	if (GetWorld()->GetTimeSeconds() - LastFireTime < FiringNetBoostTime)
+	{
+		SetNetActivity(ENSNetActivity::Firing);
+	}
+	else if (bAimChanged || GetVelocity().SizeSquared() > FMath::Square(10.0f))
+	{
+		SetNetActivity(ENSNetActivity::Moving);
+	}
+	else
+	{
+		SetNetActivity(ENSNetActivity::Idle);
+	}
+}
+
+void AfpsNSCharacter::SetNetActivity(ENSNetActivity NewActivity)
+{
+	if (GetLocalRole() != ROLE_Authority || NetActivity == NewActivity)
+	{
+		return;
+	}
+
+	const ENSNetActivity OldActivity = NetActivity;
+	NetActivity = NewActivity;
+
+	if (NewActivity == ENSNetActivity::Dormant)
+	{
+		SetNetDormancy(DORM_DormantAll);
+		return;
+	}
+
+	if (OldActivity == ENSNetActivity::Dormant)
+	{
+		SetNetDormancy(DORM_Awake);
+	}
+
+	switch (NewActivity)
+	{
+	case ENSNetActivity::Idle:
+		NetUpdateFrequency = IdleNetUpdateFrequency;
+		break;
+	case ENSNetActivity::Moving:
+		NetUpdateFrequency = MovingNetUpdateFrequency;
+		break;
+	default:
+		NetUpdateFrequency = FiringNetUpdateFrequency;
+		break;
+	}
+
+	//  ׷ Ŭ  ֱ⸦ ϹǷ   ֱ⸦  ˷ ش
+	UNetDriver* Driver = GetNetDriver();
+	if (UNSReplicationGraph* Graph = Driver ? Cast<UNSReplicationGraph>(Driver->GetReplicationDriver()) : nullptr)
+	{
+		Graph->SetActorNetUpdateFrequency(this, NetUpdateFrequency);
+	}
+
+	// 󵵰 ö󰡸  ֱ⸦ ٸ ʰ ٷ 
+	if (NewActivity > OldActivity && OldActivity != ENSNetActivity::Dormant)
+	{
+		ForceNetUpdate();
+	}
+}
+
+void AfpsNSCharacter::ServerFire_Implementation(const FNSFireCommand& Command)
+{
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_ServerFire);
+	CSV_SCOPED_TIMING_STAT(fpsNS, ServerFire);
+	INC_DWORD_STAT(STAT_fpsNS_ServerFireCalls);
+
+	if (!AcceptFireCommand(Command))
+	{
+		RejectedShots++;
+		INC_DWORD_STAT(STAT_fpsNS_ShotsRejected);
+		return;
+	}
+
+	// ߻ ̺Ʈ ʰ  ʵ Ÿ̸Ӹ ٸ ʰ ø
+	LastFireTime = GetWorld()->GetTimeSeconds();
+	SetNetActivity(ENSNetActivity::Firing);
+
+	const FVector End = Command.Origin + Command.GetDirection() * WeaponRange;
+	Fire(Command.Origin, End, Command.GetViewTime(GetWorld()->GetTimeSeconds()));
+}
+
+void AfpsNSCharacter::RecordShotEvent(const FVector& Muzzle, const FVector& HitPoint)
+{
+	ShotEvents.AddShot(NextShotEventSequence++, Muzzle, HitPoint);
+
+	//   ȣƮ   Ƿ  Ѵ
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		FNSShotEvent Event;
+		Event.Muzzle = Muzzle;
+		Event.HitPoint = HitPoint;
+		PlayShotEffects(Event);
+	}
+}
+
+void AfpsNSCharacter::PlayShotEffects(const FNSShotEvent& Event)
 {
 	// ƴٸ ߻ ִϸ̼  õѴ
 	if (TP_FireAnimation != nullptr)
@@ -304,15 +605,50 @@ void AfpsNSCharacter::MultiCastShootEffects_Implementation()
 
 	if (BulletParticle != nullptr)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletParticle->Template, BulletParticle->GetComponentLocation(), BulletParticle->GetComponentRotation());
+		UNSEffectPool* EffectPool = GetWorld()->GetSubsystem<UNSEffectPool>();
+		if (EffectPool != nullptr)
+		{
+			EffectPool->SpawnEmitterAtLocation(BulletParticle->Template, Event.Muzzle, (Event.HitPoint - Event.Muzzle).Rotation());
+		}
 	}
 }
 
-void AfpsNSCharacter::MultiCastRagdoll_Implementation()
+void AfpsNSCharacter::OnRep_IsDead()
 {
-	GetMesh()->SetPhysicsBlendWeight(1.0f);
-	GetMesh()->SetSimulatePhysics(true);
-	GetMesh()->SetCollisionProfileName("Ragdoll");
+	// ùķ̼   ó ׵ Ŵ ô´
+	UNSRagdollManager* RagdollManager = GetWorld()->GetSubsystem<UNSRagdollManager>();
+	if (RagdollManager == nullptr)
+	{
+		return;
+	}
+
+	if (bIsDead)
+	{
+		RagdollManager->RequestRagdoll(this);
+	}
+	else
+	{
+		RagdollManager->ReleaseRagdoll(this);
+		ResetMesh();
+	}
+}
+
+void AfpsNSCharacter::ResetMesh()
+{
+	USkeletalMeshComponent* Mesh = GetMesh();
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetPhysicsBlendWeight(0.0f);
+	Mesh->SetCollisionProfileName("CharacterMesh");
+	Mesh->SetComponentTickEnabled(true);
+
+	//  ִϸ̼ ִ Ʈ ߴٸ ǵ
+	if (Mesh->GetAnimationMode() == EAnimationMode::AnimationSingleNode)
+	{
+		Mesh->SetAnimationMode(EAnimationMode::AnimationBlueprint);
+	}
+
+	Mesh->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	Mesh->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
 }
 
 void AfpsNSCharacter::PlayPain_Implementation()
@@ -350,30 +686,105 @@ void AfpsNSCharacter::Respawn()
 {
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		//  κ ġ 
-		NSPlayerState->Health = 100.0f;
+		//  尡   Ǯ ְ ٽ ġѴ
 		Cast<AfpsNSGameMode>(GetWorld()->GetAuthGameMode())->Respawn(this);
-		Destroy(true, true);
 	}
 }
 
-void AfpsNSCharacter::SetTeam_Implementation(ETeam NewTeam)
+void AfpsNSCharacter::ResetForRespawn()
 {
-	FLinearColor outColor;
-	if (NewTeam == ETeam::BLUE_TEAM)
+	if (GetLocalRole() == ROLE_Authority)
 	{
-		outColor = FLinearColor(0.0f, 0.0f, 0.5f);
+		if (NSPlayerState != nullptr)
+		{
+			NSPlayerState->SetHealth(ANSPlayerState::MaxHealth);
+		}
+
+		FireRateLimiter.Reset();
+		bHasFireSequence = false;
+
+		if (bIsDead)
+		{
+			bIsDead = false;
+			OnRep_IsDead();
+		}
 	}
-	else
+}
+
+void AfpsNSCharacter::SetCurrentTeam(ETeam NewTeam)
+{
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		CurrentTeam = NewTeam;
+		OnRep_CurrentTeam();
+	}
+}
+
+void AfpsNSCharacter::OnRep_CurrentTeam()
+{
+	UpdateTeamMaterial();
+}
+
+void AfpsNSCharacter::UpdateTeamMaterial()
+{
+	// Ƽ     
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	UNSTeamMaterialCache* MaterialCache = GetWorld()->GetSubsystem<UNSTeamMaterialCache>();
+	UMaterialInstanceDynamic* TeamMaterial = MaterialCache ? MaterialCache->GetTeamMaterial(CurrentTeam, GetMesh()->GetMaterial(0)) : nullptr;
+	if (TeamMaterial == nullptr)
 	{
-		outColor = FLinearColor(0.5f, 0.0f, 0.0f);
+		return;
 	}
 
-	if (DynamicMat == nullptr)
+	GetMesh()->SetMaterial(0, TeamMaterial);
+	if (FP_Mesh != nullptr)
 	{
-		DynamicMat = UMaterialInstanceDynamic::Create(GetMesh()->GetMaterial(0), this);
-		DynamicMat->SetVectorParameterValue(TEXT("BodyColor"), outColor);
-		GetMesh()->SetMaterial(0, DynamicMat);
-		FP_Mesh->SetMaterial(0, DynamicMat);
+		FP_Mesh->SetMaterial(0, TeamMaterial);
 	}
 }
+
+#if !UE_BUILD_SHIPPING
+// ĳ ϳ  ϴ Ʈ  ޸𸮸 Ѵ
+static void LogCharacterCost(const TArray<FString>& Args, UWorld* World)
+{
+	int32 NumCharacters = 0;
+	int32 NumComponents = 0;
+	int32 NumTicking = 0;
+	SIZE_T Bytes = 0;
+
+	for (TActorIterator<AfpsNSCharacter> It(World); It; ++It)
+	{
+		++NumCharacters;
+		Bytes += It->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		TInlineComponentArray<UActorComponent*> Components(*It);
+		for (UActorComponent* Component : Components)
+		{
+			++NumComponents;
+			Bytes += Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			if (Component->IsComponentTickEnabled())
+			{
+				++NumTicking;
+			}
+		}
+	}
+
+	if (NumCharacters == 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("CharacterCost: no characters"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("CharacterCost: %d characters, %.1f components (%.1f ticking), %.1f KB each"),
+		NumCharacters, float(NumComponents) / NumCharacters, float(NumTicking) / NumCharacters, Bytes / 1024.0 / NumCharacters);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdCharacterCost(
+	TEXT("fpsNS.CharacterCost"),
+	TEXT("Logs per-character component count, ticking components and memory. Compare client and dedicated server."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&LogCharacterCost));
+#endif
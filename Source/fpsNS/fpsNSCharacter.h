@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "fpsNSGameMode.h"
 #include "NSPlayerState.h"
+#include "NSLagCompensation.h"
+#include "NSFireCommand.h"
+#include "NSShotEvents.h"
 #include "GameFramework/Character.h"
 #include "fpsNSCharacter.generated.h"
 
@@ -12,10 +15,19 @@ class UInputComponent;
 class USkeletalMeshComponent;
 class USceneComponent;
 class UCameraComponent;
-class UMotionControllerComponent;
 class UAnimMontage;
+class UAnimationAsset;
 class USoundBase;
 
+//  ĳ  󵵸  Ȱ 
+enum class ENSNetActivity : uint8
+{
+	Dormant,	// ׾ų Ǯ ִ.   ʴ´
+	Idle,
+	Moving,
+	Firing,
+};
+
 UCLASS(config=Game)
 class AfpsNSCharacter : public ACharacter
 {
@@ -41,14 +53,6 @@ class AfpsNSCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FirstPersonCameraComponent;
 
-	/** Motion controller (right hand) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
-	UMotionControllerComponent* R_MotionController;
-
-	/** Motion controller (left hand) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
-	UMotionControllerComponent* L_MotionController;
-
 public:
 	AfpsNSCharacter();
 
@@ -59,7 +63,9 @@ protected:
 
 	virtual float TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void PossessedBy(AController* NewController) override;
 
 public:
@@ -98,24 +104,67 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	UParticleSystemComponent* BulletParticle;
 
+	/** ׵  Ѿ     ִϸ̼ */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
+	UAnimationAsset* DeathAnimation;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	UForceFeedbackEffect* HitSuccessFeedback;
 
+	/** Ʈĵ Ÿ.  ߻    Ѵ */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
+	float WeaponRange;
+
+	/**  ϴ ʴ ߻  */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Gameplay)
+	float FireRate;
+
+	/**  Ǵ ߻  (ū Ŷ ũ) */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Gameplay)
+	float FireBurst;
+
+	/** ߻   ī޶ ġ   (cm) */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Gameplay)
+	float MaxFireOriginError;
+
+	/**    ʴ  Ƚ */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Replication)
+	float IdleNetUpdateFrequency;
+
+	/** ̰ų  ٲ  ʴ  Ƚ */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Replication)
+	float MovingNetUpdateFrequency;
+
+	/** ߻  ʴ  Ƚ */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Replication)
+	float FiringNetUpdateFrequency;
+
+	/**  ߻   ð  ߻   () */
+	UPROPERTY(GlobalConfig, EditAnywhere, BlueprintReadOnly, Category = Replication)
+	float FiringNetBoostTime;
+
 	/** Whether to use motion controller location for aiming. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	uint8 bUsingMotionControllers : 1;
 	
 public:
-	UPROPERTY(Replicated, BlueprintReadWrite, Category = Team)
+	//  SetCurrentTeam ٲ۴. Ŭ̾Ʈ OnRep  ٲ۴
+	UPROPERTY(ReplicatedUsing = OnRep_CurrentTeam, BlueprintReadOnly, Category = Team)
 	ETeam CurrentTeam;
 
+	//  . ʰ  Ŭ̾Ʈ ׵ ¸ ޴´
+	UPROPERTY(ReplicatedUsing = OnRep_IsDead, BlueprintReadOnly, Category = Gameplay)
+	bool bIsDead;
+
 protected:
-	class UMaterialInstanceDynamic* DynamicMat;
 	class ANSPlayerState* NSPlayerState;
 	
 	/** Fires a projectile. */
 	void OnFire();
 
+	// ȣƮ κ񿡼 ⸦ Ѵ
+	void OnStartMatch();
+
 	/** Handles moving forward/backward */
 	void MoveForward(float Val);
 
@@ -135,24 +184,61 @@ protected:
 	void LookUpAtRate(float Rate);
 
 	// Ʈ̽  ϱ  ȣȴ
-	void Fire(const FVector pos, const FVector dir);
+	void Fire(const FVector pos, const FVector end, float ViewTime);
+
+	//   Ʈڽ 
+	FNSHitboxHistory HitboxHistory;
+
+	//  ߻  
+	uint8 NextFireSequence;
+
+	//    ߻ 
+	uint8 LastFireSequence;
+	bool bHasFireSequence;
+
+	FNSFireRateLimiter FireRateLimiter;
+
+	// Ŭ̾Ʈ  ߻ ̺Ʈ
+	UPROPERTY(Replicated)
+	FNSShotEventArray ShotEvents;
+
+	uint8 NextShotEventSequence;
+
+	// źε ߻ 
+	uint32 RejectedShots;
+
+	// Ʈ̽  O(1) ˻ ߻  Ÿ
+	bool AcceptFireCommand(const FNSFireCommand& Command);
+
+	UFUNCTION()
+	void OnRep_IsDead();
+
+	UFUNCTION()
+	void OnRep_CurrentTeam();
+
+	// ü 1Ī ޽ÿ  Ƽ 
+	void UpdateTeamMaterial();
+
+	// ׵  ޽ø ĸ ٽ δ
+	void ResetMesh();
+
+	// Ƽ     Ʈ Ѵ
+	void StripCosmetics();
+
+	// ӵ, ,  ߻ ð Ȱ ¸ ٽ  (, Ÿ̸)
+	void UpdateNetActivity();
+
+	FTimerHandle NetActivityTimer;
+	ENSNetActivity NetActivity;
+	float LastFireTime;
+	FRotator LastNetActivityRotation;
 
 private:
 	//  fire ׼ 
 	UFUNCTION(Server, Reliable, WithValidation)
-	void ServerFire(const FVector pos, const FVector dir);
-	bool ServerFire_Validate(const FVector pos, const FVector dir);
-	void ServerFire_Implementation(const FVector pos, const FVector dir);
-
-	//  Ŭ̾Ʈ ߻ ȿ ϴ ƼĳƮ
-	UFUNCTION(NetMultiCast, unreliable)
-	void MultiCastShootEffects();
-	void MultiCastShootEffects_Implementation();
-
-	//   Ŭ̾Ʈ  ϱ  ȣȴ
-	UFUNCTION(NetMultiCast, unreliable)
-	void MultiCastRagdoll();
-	void MultiCastRagdoll_Implementation();
+	void ServerFire(const FNSFireCommand& Command);
+	bool ServerFire_Validate(const FNSFireCommand& Command);
+	void ServerFire_Implementation(const FNSFireCommand& Command);
 
 	// Ʈ  Ŭ̾Ʈ  ش
 	UFUNCTION(Client, Reliable)
@@ -165,14 +251,32 @@ public:
 	/** Returns FirstPersonCameraComponent subobject **/
 	UCameraComponent* GetFirstPersonCameraComponent() const { return FirstPersonCameraComponent; }
 
+	FNSHitboxHistory& GetHitboxHistory() { return HitboxHistory; }
+
 	class ANSPlayerState* GetNSPlayerState();
 	void SetNSPlayerState(class ANSPlayerState* newPS);
 	void Respawn();
 
-	//  
-	UFUNCTION(NetMultiCast, Reliable)
-	void SetTeam(ETeam NewTeam);
-	void SetTeam_Implementation(ETeam NewTeam);
+	// Ǯ ٽ    ¸ ǵ ()
+	void ResetForRespawn();
+
+	//     Ѵ
+	void OnShotResolved(const FHitResult& HitRes);
+
+	//   ߻縦 Ŭ̾Ʈ  ̺Ʈ Ѵ
+	void RecordShotEvent(const FVector& Muzzle, const FVector& HitPoint);
+
+	// ߻ ȿ Ѵ
+	void PlayShotEffects(const FNSShotEvent& Event);
+
+	// ߻    . Է°   θ 
+	void SendFireCommand(const FVector& Origin, const FVector& Direction);
+
+	// Ȱ ¿ °  󵵿 ޸ ٲ۴ ()
+	void SetNetActivity(ENSNetActivity NewActivity);
+
+	//  ٲ۴ ().   ȣƮ OnRep  Ƿ   ٲ۴
+	void SetCurrentTeam(ETeam NewTeam);
 
 };
 
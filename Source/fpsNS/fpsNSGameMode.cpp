@@ -7,11 +7,18 @@
 #include "fpsNSHUD.h"
 #include "fpsNSCharacter.h"
 #include "NSPlayerState.h"
-#include "NSSpawnPoint.h"
+#include "NSSpawnScheduler.h"
+#include "NSPawnPool.h"
 #include "NSGameStateBase.h"
+#include "NSBotController.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
 #include "UObject/ConstructorHelpers.h"
 
-bool AfpsNSGameMode::bInGameMenu = true;
+DECLARE_DWORD_COUNTER_STAT(TEXT("Respawn Calls"), STAT_fpsNS_RespawnCalls, STATGROUP_fpsNS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spawn Calls"), STAT_fpsNS_SpawnCalls, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("GameMode Respawn"), STAT_fpsNS_GameModeRespawn, STATGROUP_fpsNS);
+DECLARE_CYCLE_STAT(TEXT("GameMode Spawn"), STAT_fpsNS_GameModeSpawn, STATGROUP_fpsNS);
 
 AfpsNSGameMode::AfpsNSGameMode()
 	: Super()
@@ -24,64 +31,71 @@ AfpsNSGameMode::AfpsNSGameMode()
 	HUDClass = AfpsNSHUD::StaticClass();
 	PlayerStateClass = ANSPlayerState::StaticClass();
 
-	bReplicates = true;
-	PrimaryActorTick.bCanEverTick = true;
+	// ܰ ȯ Ÿ̸ӿ Է ̺Ʈ óѴ
+	PrimaryActorTick.bCanEverTick = false;
 
 	GameStateClass = ANSGameStateBase::StaticClass();
+
+	// κ   ̸   ̵Ѵ
+	bUseSeamlessTravel = true;
+
+	NumTeams = 2;
+	LobbyMap = TEXT("/Game/NS/MenuMap");
+	MatchMap = TEXT("/Game/FirstPersonCPP/Maps/FirstPersonExampleMap");
+	WarmupDuration = 10.0f;
+	MatchDuration = 600.0f;
+	PostMatchDuration = 10.0f;
+	MinPlayersToStart = 0;
+	LobbyStartDelay = 10.0f;
+	NumBots = 0;
+	bIsMatchLevel = false;
 }
 
-void AfpsNSGameMode::BeginPlay()
+void AfpsNSGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
-	Super::BeginPlay();
-	if (GetLocalRole() == ROLE_Authority)
-	{
-		Cast<ANSGameStateBase>(GameState)->bInMenu = bInGameMenu;
+	Super::InitGame(MapName, Options, ErrorMessage);
 
-		for (TActorIterator<ANSSpawnPoint> Iter(GetWorld()); Iter; ++Iter)
-		{
-			if ((*Iter)->Team == ETeam::RED_TEAM)
-			{
-				RedSpawns.Add(*Iter);
-			}
-			else
-			{
-				BlueSpawns.Add(*Iter);
-			}
-		}
+	NumTeams = FMath::Clamp(UGameplayStatics::GetIntOption(Options, TEXT("NumTeams"), NumTeams), 2, int32(ETeam::MAX));
+	Teams.Reset(NumTeams);
 
-		//  
-		APlayerController* thisCont = GetWorld()->GetFirstPlayerController();
-		if (thisCont)
-		{
-			AfpsNSCharacter* thisChar = Cast<AfpsNSCharacter>(thisCont->GetPawn());
-			thisChar->SetTeam(ETeam::BLUE_TEAM);
-			BlueTeam.Add(thisChar);
-			Spawn(thisChar);
-		}
+	bIsMatchLevel = UGameplayStatics::HasOption(Options, TEXT("Match"));
+
+	// Ƽ   ڷε   ְ Ѵ. URL ɼ 켱Ѵ
+	FParse::Value(FCommandLine::Get(), TEXT("NSBots="), NumBots);
+	NumBots = FMath::Max(0, UGameplayStatics::GetIntOption(Options, TEXT("NSBots"), NumBots));
+}
+
+void AfpsNSGameMode::InitGameState()
+{
+	Super::InitGameState();
+
+	if (ANSGameStateBase* NSGameState = Cast<ANSGameStateBase>(GameState))
+	{
+		NSGameState->NumTeams = NumTeams;
 	}
 }
 
-void AfpsNSGameMode::Tick(float DeltaSeconds)
+void AfpsNSGameMode::BeginPlay()
 {
+	Super::BeginPlay();
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		APlayerController* thisCont = GetWorld()->GetFirstPlayerController();
+		EnterPhase(bIsMatchLevel ? ENSMatchPhase::Warmup : ENSMatchPhase::Lobby);
 
-		if (ToBeSpawned.Num() != 0)
+		//  
+		APlayerController* thisCont = GetWorld()->GetFirstPlayerController();
+		if (thisCont)
 		{
-			for (auto charToSpawn : ToBeSpawned)
+			AfpsNSCharacter* thisChar = Cast<AfpsNSCharacter>(thisCont->GetPawn());
+			ANSPlayerState* thisPS = Cast<ANSPlayerState>(thisCont->PlayerState);
+			if (thisChar && thisPS)
 			{
-				Spawn(charToSpawn);
+				thisChar->SetCurrentTeam(AssignTeam(thisPS));
+				Spawn(thisChar);
 			}
 		}
 
-		if (thisCont != nullptr && thisCont->IsInputKeyDown(EKeys::R))
-		{
-			bInGameMenu = false;
-			GetWorld()->ServerTravel(L"/Game/FirstPersonCPP/Maps/FirstPersonExampleMap?Listen");
-
-			Cast<ANSGameStateBase>(GameState)->bInMenu = bInGameMenu;
-		}
+		SpawnBots();
 	}
 }
 
@@ -89,6 +103,20 @@ void AfpsNSGameMode::PostLogin(APlayerController* NewPlayer)
 {
 	Super::PostLogin(NewPlayer);
 
+	// κ ο  ڵ  Ѵ
+	if (!bIsMatchLevel && GetMatchPhase() == ENSMatchPhase::Lobby && MinPlayersToStart > 0
+		&& GetNumPlayers() >= MinPlayersToStart && !GetWorldTimerManager().IsTimerActive(PhaseTimer))
+	{
+		GetWorldTimerManager().SetTimer(PhaseTimer, this, &AfpsNSGameMode::AdvancePhase, LobbyStartDelay, false);
+		Cast<ANSGameStateBase>(GameState)->SetMatchPhase(ENSMatchPhase::Lobby, LobbyStartDelay);
+	}
+}
+
+void AfpsNSGameMode::HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer)
+{
+	//  Ӱ ɸ ̵  ⸦ Ƿ    ⼭ Ѵ
+	Super::HandleStartingNewPlayer_Implementation(NewPlayer);
+
 	AfpsNSCharacter* Teamless = Cast<AfpsNSCharacter>(NewPlayer->GetPawn());
 	ANSPlayerState* NPlayerState = Cast<ANSPlayerState>(NewPlayer->PlayerState);
 
@@ -98,109 +126,186 @@ void AfpsNSGameMode::PostLogin(APlayerController* NewPlayer)
 	}
 
 	//    
-	if (GetLocalRole() == ROLE_Authority && Teamless != nullptr)
+	if (GetLocalRole() == ROLE_Authority && Teamless != nullptr && NPlayerState != nullptr)
 	{
-		if (BlueTeam.Num() > RedTeam.Num())
-		{
-			RedTeam.Add(Teamless);
-			NPlayerState->Team = ETeam::RED_TEAM;
-		}
-		else if (BlueTeam.Num() < RedTeam.Num())
+		Teamless->SetCurrentTeam(AssignTeam(NPlayerState));
+		Spawn(Teamless);
+	}
+}
+
+void AfpsNSGameMode::Logout(AController* Exiting)
+{
+	//  ÷̾ ڸ     ݿѴ
+	if (ANSPlayerState* ExitingPS = Cast<ANSPlayerState>(Exiting->PlayerState))
+	{
+		Teams.Leave(ExitingPS->TeamHandle);
+		ExitingPS->TeamHandle = FNSTeamHandle();
+	}
+
+	Super::Logout(Exiting);
+}
+
+ETeam AfpsNSGameMode::AssignTeam(ANSPlayerState* PlayerState)
+{
+	if (!Teams.IsValid(PlayerState->TeamHandle, PlayerState))
+	{
+		//     忡    ٽ 
+		if (PlayerState->bTeamAssigned && int32(PlayerState->GetTeam()) < Teams.GetNumTeams())
 		{
-			BlueTeam.Add(Teamless);
-			NPlayerState->Team = ETeam::BLUE_TEAM;
+			PlayerState->TeamHandle = Teams.Join(PlayerState, PlayerState->GetTeam());
 		}
-		else //  
+		else
 		{
-			BlueTeam.Add(Teamless);
-			NPlayerState->Team = ETeam::BLUE_TEAM;
+			PlayerState->TeamHandle = Teams.JoinSmallestTeam(PlayerState);
 		}
+		PlayerState->SetTeam(Teams.GetTeam(PlayerState->TeamHandle));
+		PlayerState->bTeamAssigned = true;
+	}
+	return PlayerState->GetTeam();
+}
 
-		Teamless->CurrentTeam = NPlayerState->Team;
-		Teamless->SetTeam(NPlayerState->Team);
-		Spawn(Teamless);
+void AfpsNSGameMode::StartMatch()
+{
+	if (GetMatchPhase() != ENSMatchPhase::Lobby)
+	{
+		return;
+	}
+
+	GetWorldTimerManager().ClearTimer(PhaseTimer);
+
+	GetWorld()->ServerTravel(MatchMap + GetTravelOptions() + TEXT("?Match"));
+}
+
+FString AfpsNSGameMode::GetTravelOptions() const
+{
+	const TCHAR* ListenOption = GetNetMode() == NM_ListenServer ? TEXT("?Listen") : TEXT("");
+	return FString::Printf(TEXT("%s?NumTeams=%d?NSBots=%d"), ListenOption, NumTeams, NumBots);
+}
+
+void AfpsNSGameMode::EnterPhase(ENSMatchPhase NewPhase)
+{
+	float Duration = 0.0f;
+	switch (NewPhase)
+	{
+	case ENSMatchPhase::Warmup:
+		Duration = WarmupDuration;
+		break;
+	case ENSMatchPhase::InProgress:
+		Duration = MatchDuration;
+		break;
+	case ENSMatchPhase::PostMatch:
+		Duration = PostMatchDuration;
+		break;
+	default:
+		break;
+	}
+
+	Cast<ANSGameStateBase>(GameState)->SetMatchPhase(NewPhase, Duration);
+
+	if (Duration > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(PhaseTimer, this, &AfpsNSGameMode::AdvancePhase, Duration, false);
+	}
+	else
+	{
+		GetWorldTimerManager().ClearTimer(PhaseTimer);
 	}
 }
 
-void AfpsNSGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+void AfpsNSGameMode::AdvancePhase()
 {
-	if (EndPlayReason == EEndPlayReason::Quit || EndPlayReason == EEndPlayReason::EndPlayInEditor)
+	switch (GetMatchPhase())
 	{
-		bInGameMenu = true;
+	case ENSMatchPhase::Lobby:
+		StartMatch();
+		break;
+	case ENSMatchPhase::Warmup:
+		EnterPhase(ENSMatchPhase::InProgress);
+		break;
+	case ENSMatchPhase::InProgress:
+		EnterPhase(ENSMatchPhase::PostMatch);
+		break;
+	case ENSMatchPhase::PostMatch:
+	{
+		// Ⱑ  κ ư
+		GetWorld()->ServerTravel(LobbyMap + GetTravelOptions());
+		break;
+	}
+	}
+}
+
+ENSMatchPhase AfpsNSGameMode::GetMatchPhase() const
+{
+	const ANSGameStateBase* NSGameState = Cast<ANSGameStateBase>(GameState);
+	return NSGameState ? NSGameState->MatchPhase : ENSMatchPhase::Lobby;
+}
+
+void AfpsNSGameMode::SpawnBots()
+{
+	UNSPawnPool* Pool = GetWorld()->GetSubsystem<UNSPawnPool>();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		ANSBotController* Bot = GetWorld()->SpawnActor<ANSBotController>(ANSBotController::StaticClass(), SpawnParams);
+		ANSPlayerState* BotPS = Bot ? Cast<ANSPlayerState>(Bot->PlayerState) : nullptr;
+		AfpsNSCharacter* BotChar = BotPS ? Pool->AcquirePawn(DefaultPawnClass.Get()) : nullptr;
+		if (BotChar == nullptr)
+		{
+			continue;
+		}
+
+		BotPS->SetPlayerName(FString::Printf(TEXT("Bot %d"), Index + 1));
+		Bot->Possess(BotChar);
+
+		BotChar->SetNSPlayerState(BotPS);
+		BotChar->SetCurrentTeam(AssignTeam(BotPS));
+		Spawn(BotChar);
 	}
 }
 
 void AfpsNSGameMode::Respawn(AfpsNSCharacter* Character)
 {
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_GameModeRespawn);
+	CSV_SCOPED_TIMING_STAT(fpsNS, Respawn);
+	INC_DWORD_STAT(STAT_fpsNS_RespawnCalls);
+
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		AController* thisPC = Character->GetController();
-		Character->DetachFromControllerPendingDestroy();
+		UNSPawnPool* Pool = GetWorld()->GetSubsystem<UNSPawnPool>();
 
-		AfpsNSCharacter* newChar = Cast<AfpsNSCharacter>(GetWorld()->SpawnActor(DefaultPawnClass));
+		//   ı ʰ Ǯ   ٽ .    ´
+		Pool->ReleasePawn(Character);
+		AfpsNSCharacter* newChar = thisPC ? Pool->AcquirePawn(DefaultPawnClass.Get()) : nullptr;
 
 		if (newChar)
 		{
 			thisPC->Possess(newChar);
 			ANSPlayerState* thisPS = Cast<ANSPlayerState>(newChar->GetController()->PlayerState);
 
-			newChar->CurrentTeam = thisPS->Team;
+			newChar->SetCurrentTeam(thisPS->GetTeam());
 			newChar->SetNSPlayerState(thisPS);
 
 			Spawn(newChar);
-
-			newChar->SetTeam(newChar->GetNSPlayerState()->Team);
 		}
 	}
 }
 
 void AfpsNSGameMode::Spawn(AfpsNSCharacter* Character)
 {
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_GameModeSpawn);
+	CSV_SCOPED_TIMING_STAT(fpsNS, Spawn);
+	INC_DWORD_STAT(STAT_fpsNS_SpawnCalls);
+
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		// ϵ    ã
-		ANSSpawnPoint* thisSpawn = nullptr;
-		TArray<ANSSpawnPoint*>* targetTeam = nullptr;
-
-		if (Character->CurrentTeam == ETeam::BLUE_TEAM)
+		// ٷ        ȿ ġѴ
+		if (UNSSpawnScheduler* Scheduler = GetWorld()->GetSubsystem<UNSSpawnScheduler>())
 		{
-			targetTeam = &BlueSpawns;
-		}
-		else
-		{
-			targetTeam = &RedSpawns;
-		}
-
-		if (ToBeSpawned.Find(Character) == INDEX_NONE)
-		{
-			ToBeSpawned.Add(Character);
-		}
-
-		for (auto Spawn : (*targetTeam))
-		{
-			UE_LOG(LogTemp, Log, TEXT("Spawn Point = %s is Blocked = %s"), *Spawn->GetFName().ToString(), Spawn->GetBlocked() ? TEXT("true") : TEXT("false"));
-			TSet<AActor*> actors;
-			Spawn->GetOverlappingActors(actors);
-			for (auto overlapActor : actors)
-			{
-				UE_LOG(LogTemp, Log, TEXT("Spawn Point OverlapActor = %s"), *overlapActor->GetFName().ToString());
-			}
-
-			if (actors.Num() == 0)
-			//if(Spawn->isTaken == false)
-			{
-				//  ť ġ 
-				if (ToBeSpawned.Find(Character) != INDEX_NONE)
-				{
-					ToBeSpawned.Remove(Character);
-				}
-
-				// ׷   ġ 
-				Character->SetActorLocation(Spawn->GetActorLocation());
-				Spawn->UpdateOverlaps();
-				//Spawn->isTaken = true;
-				return;
-			}
+			Scheduler->RequestSpawn(Character);
 		}
 	}
 }
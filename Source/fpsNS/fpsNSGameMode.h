@@ -4,16 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "NSTeamRegistry.h"
+#include "NSGameStateBase.h"
 #include "fpsNSGameMode.generated.h"
 
-UENUM(BlueprintType)
-enum class ETeam : uint8
-{
-	BLUE_TEAM,
-	RED_TEAM
-};
-
-UCLASS(minimalapi)
+UCLASS(minimalapi, config=Game)
 class AfpsNSGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
@@ -21,23 +16,73 @@ class AfpsNSGameMode : public AGameModeBase
 public:
 	AfpsNSGameMode();
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	virtual void InitGameState() override;
 	virtual void PostLogin(APlayerController* NewPlayer) override;
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
 
 	void Respawn(class AfpsNSCharacter* Character);
 	void Spawn(class AfpsNSCharacter* Character);
 
+	// κ񿡼   ̵Ѵ.  ܼ̳ ȣƮ Է ȣѴ
+	UFUNCTION(Exec)
+	void StartMatch();
+
+	/**  . URL ɼ ?NumTeams=N   ִ */
+	UPROPERTY(Config)
+	int32 NumTeams;
+
+	UPROPERTY(Config)
+	FString LobbyMap;
+
+	UPROPERTY(Config)
+	FString MatchMap;
+
+	/**  ܰ  (). 0̸ ڵ Ѿ ʴ´ */
+	UPROPERTY(Config)
+	float WarmupDuration;
+
+	UPROPERTY(Config)
+	float MatchDuration;
+
+	UPROPERTY(Config)
+	float PostMatchDuration;
+
+	/** κ  ο ̸ LobbyStartDelay  ڵ Ѵ. 0̸ θ Ѵ */
+	UPROPERTY(Config)
+	int32 MinPlayersToStart;
+
+	UPROPERTY(Config)
+	float LobbyStartDelay;
+
+	/**  ä  . ?NSBots=N ɼ̳ -NSBots=N ڷ   ִ */
+	UPROPERTY(Config)
+	int32 NumBots;
+
 private:
-	TArray<class AfpsNSCharacter*> RedTeam;
-	TArray<class AfpsNSCharacter*> BlueTeam;
+	// ̹   ϰ,  ο    ִ´
+	ETeam AssignTeam(class ANSPlayerState* PlayerState);
+
+	void EnterPhase(ENSMatchPhase NewPhase);
+
+	//  ̵ URL  ɼ.          ʿ ̾
+	FString GetTravelOptions() const;
+
+	//  Ʈѷ  ÷̾     Ѵ
+	void SpawnBots();
+
+	// ܰ Ÿ̸Ӱ   ܰ Ѿ
+	void AdvancePhase();
+
+	ENSMatchPhase GetMatchPhase() const;
+
+	FNSTeamRegistry Teams;
 
-	TArray<class ANSSpawnPoint*> RedSpawns;
-	TArray<class ANSSpawnPoint*> BlueSpawns;
-	TArray<class AfpsNSCharacter*> ToBeSpawned;
+	//   ̵  ̸ ־ Ѵ
+	bool bIsMatchLevel;
 
-	bool bGameStarted;
-	static bool bInGameMenu;
+	FTimerHandle PhaseTimer;
 };
 
 
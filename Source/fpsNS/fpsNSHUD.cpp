@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "fpsNSHUD.h"
+#include "fpsNS.h"
 #include "Engine/Canvas.h"
 #include "Engine/Texture2D.h"
 #include "TextureResource.h"
@@ -12,6 +13,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
 
+DECLARE_CYCLE_STAT(TEXT("HUD Draw"), STAT_fpsNS_HUDDraw, STATGROUP_fpsNS);
+
 AfpsNSHUD::AfpsNSHUD()
 {
 	// Set the crosshair texture
@@ -22,6 +25,10 @@ AfpsNSHUD::AfpsNSHUD()
 
 void AfpsNSHUD::DrawHUD()
 {
+	SCOPE_CYCLE_COUNTER(STAT_fpsNS_HUDDraw);
+	CSV_SCOPED_TIMING_STAT(fpsNS, HUDDraw);
+	const double StartTime = FPlatformTime::Seconds();
+
 	Super::DrawHUD();
 
 	// Draw very simple crosshair
@@ -40,37 +47,31 @@ void AfpsNSHUD::DrawHUD()
 
 	ANSGameStateBase* thisGameState = Cast<ANSGameStateBase>(GetWorld()->GetGameState());
 
-	if (thisGameState != nullptr && thisGameState->bInMenu)
+	if (thisGameState != nullptr && thisGameState->IsInLobby())
 	{
-		int BlueScreenPos = 50;
-		int RedScreenPos = Center.Y + 50;
+		//  ȭ η  ̸ Ѵ
+		const int32 NumTeams = FMath::Clamp<int32>(thisGameState->NumTeams, 1, int32(ETeam::MAX));
+		const UEnum* TeamEnum = StaticEnum<ETeam>();
 		int nameSpacing = 25;
-		int NumBlueteam = 1;
-		int NumRedTeam = 1;
-
-		FString thisString = "BLUE TEAM:";
-		DrawText(thisString, FColor::Cyan, 50, BlueScreenPos);
+		TArray<int32, TInlineAllocator<int32(ETeam::MAX)>> NumInTeam;
+		NumInTeam.SetNumZeroed(NumTeams);
 
-		thisString = "RED TEAM:";
-		DrawText(thisString, FColor::Red, 50, RedScreenPos);
+		FString thisString;
+		for (int32 Team = 0; Team < NumTeams; ++Team)
+		{
+			thisString = TeamEnum->GetNameStringByValue(Team).Replace(TEXT("_"), TEXT(" ")) + TEXT(":");
+			DrawText(thisString, (GetTeamColor(ETeam(Team)) * 2.0f).ToFColor(true), 50, Canvas->ClipY * Team / NumTeams + 50);
+		}
 
 		for (auto player : thisGameState->PlayerArray)
 		{
 			ANSPlayerState* thisPS = Cast<ANSPlayerState>(player);
-			if (thisPS)
+			if (thisPS && int32(thisPS->GetTeam()) < NumTeams)
 			{
-				if (thisPS->Team == ETeam::BLUE_TEAM)
-				{
-					thisString = FString::Printf(TEXT("%s"), *thisPS->GetPlayerName());
-					DrawText(thisString, FColor::Cyan, 50, BlueScreenPos + nameSpacing * NumBlueteam);
-					NumBlueteam++;
-				}
-				else
-				{
-					thisString = FString::Printf(TEXT("%s"), *thisPS->GetPlayerName());
-					DrawText(thisString, FColor::Red, 50, RedScreenPos + nameSpacing * NumRedTeam);
-					NumRedTeam++;
-				}
+				const int32 Team = int32(thisPS->GetTeam());
+				NumInTeam[Team]++;
+				thisString = FString::Printf(TEXT("%s"), *thisPS->GetPlayerName());
+				DrawText(thisString, (GetTeamColor(thisPS->GetTeam()) * 2.0f).ToFColor(true), 50, Canvas->ClipY * Team / NumTeams + 50 + nameSpacing * NumInTeam[Team]);
 			}
 		}
 
@@ -90,9 +91,20 @@ void AfpsNSHUD::DrawHUD()
 		AfpsNSCharacter* ThisChar = Cast<AfpsNSCharacter>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
 		if (ThisChar != nullptr && ThisChar->GetNSPlayerState() != nullptr)
 		{
-			FString HUDString = FString::Printf(TEXT("Health: %f, Score: %.0f, Death: %d"), 
-				ThisChar->GetNSPlayerState()->Health, ThisChar->GetNSPlayerState()->Score, ThisChar->GetNSPlayerState()->Deaths);
+			FString HUDString = FString::Printf(TEXT("Health: %d, Score: %.0f, Death: %d"), 
+				FMath::RoundToInt(ThisChar->GetNSPlayerState()->GetHealth()), ThisChar->GetNSPlayerState()->GetScore(), ThisChar->GetNSPlayerState()->GetDeaths());
 			DrawText(HUDString, FColor::Yellow, 50, 50);
 		}
+
+		// ־   Ŀ  ð ش
+		if (thisGameState != nullptr && thisGameState->GetPhaseTimeRemaining() > 0.0f && thisGameState->MatchPhase != ENSMatchPhase::InProgress)
+		{
+			const TCHAR* PhaseName = thisGameState->MatchPhase == ENSMatchPhase::Warmup ? TEXT("Warmup") : TEXT("Match Over");
+			FString PhaseString = FString::Printf(TEXT("%s: %.0f"), PhaseName, FMath::CeilToFloat(thisGameState->GetPhaseTimeRemaining()));
+			DrawText(PhaseString, FColor::Yellow, Center.X, 50);
+		}
 	}
+
+	DrawSeconds += FPlatformTime::Seconds() - StartTime;
+	++DrawCount;
 }
@@ -17,7 +17,13 @@ public:
 	/** Primary draw call for the HUD */
 	virtual void DrawHUD() override;
 
+	// ݱ ׸   DrawHUD ð ()
+	double GetAverageDrawSeconds() const { return DrawCount > 0 ? DrawSeconds / DrawCount : 0.0; }
+
 private:
+	double DrawSeconds = 0.0;
+	int32 DrawCount = 0;
+
 	/** Crosshair asset pointer */
 	class UTexture2D* CrosshairTex;
 
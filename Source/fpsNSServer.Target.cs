@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class fpsNSServerTarget : TargetRules
+{
+	public fpsNSServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V2;
+
+		// Push model needs a unique build environment, which only a source engine can build.
+		// On an installed (launcher) engine the MARK_PROPERTY_DIRTY calls compile away and
+		// push-based properties replicate by comparison as before.
+		if (!UnrealBuildTool.IsEngineInstalled())
+		{
+			BuildEnvironment = TargetBuildEnvironment.Unique;
+			bWithPushModel = true;
+		}
+
+		ExtraModuleNames.Add("fpsNS");
+
+		// Keep the CSV profiler and logging in shipping server builds for capacity runs (-csvprofile).
+		// These also change the shared environment, so they need a source engine too.
+		if (Target.Configuration == UnrealTargetConfiguration.Shipping && !UnrealBuildTool.IsEngineInstalled())
+		{
+			bUseLoggingInShipping = true;
+			GlobalDefinitions.Add("CSV_PROFILER=1");
+		}
+	}
+}